@@ -10,6 +10,7 @@
 #ifndef CUDNN_CUDNNTYPES_H
 #define CUDNN_CUDNNTYPES_H
 
+#include "iree/compiler/Dialect/Util/IR/UtilTypes.h"
 #include "mlir/IR/BuiltinTypes.h"
 #include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNEnums.h.inc"
 
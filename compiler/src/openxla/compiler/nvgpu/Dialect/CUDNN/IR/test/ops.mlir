@@ -37,3 +37,50 @@ func.func @main(%arg0: tensor<1x4x4x32xf32>) -> tensor<1x4x4x32xf32> {
   %0 = cudnn.call @graph(%arg0) : (tensor<1x4x4x32xf32>) -> tensor<1x4x4x32xf32>
   return %0 : tensor<1x4x4x32xf32>
 }
+
+// -----
+
+cudnn.graph @conv_bias_relu(%x: !cudnn.tensor<1x8x32x32xf32, NHWC>,
+                            %w: !cudnn.tensor<16x8x3x3xf32, NHWC>,
+                            %b: !cudnn.tensor<1x16x1x1xf32, NHWC>)
+                              -> !cudnn.tensor<1x16x32x32xf32, NHWC> {
+  %0 = cudnn.cross_correlation(%x, %w) type = f32 alpha = 1.0 beta = 0.0
+         spatial_dim_count = 2 spatial_stride = [1, 1] pre_padding = [1, 1]
+         post_padding = [1, 1] dilation = [1, 1]
+       : !cudnn.tensor<1x8x32x32xf32, NHWC>, !cudnn.tensor<16x8x3x3xf32, NHWC>
+         -> !cudnn.tensor<1x16x32x32xf32, NHWC>
+  %1 = cudnn.pointwise_add(%0, %b) type = f32
+       : !cudnn.tensor<1x16x32x32xf32, NHWC>, !cudnn.tensor<1x16x1x1xf32, NHWC>
+         -> !cudnn.tensor<1x16x32x32xf32, NHWC>
+  %2 = cudnn.pointwise_relu(%1) type = f32 lower_clip = 0.0
+       : !cudnn.tensor<1x16x32x32xf32, NHWC>
+         -> !cudnn.tensor<1x16x32x32xf32, NHWC>
+  cudnn.return %2 : !cudnn.tensor<1x16x32x32xf32, NHWC>
+}
+
+// CHECK: cudnn.graph @conv_bias_relu
+// CHECK:   cudnn.cross_correlation
+// CHECK:   cudnn.pointwise_add
+// CHECK:   cudnn.pointwise_relu
+
+// -----
+
+cudnn.graph @matmul_bias_gelu(%a: !cudnn.tensor<4x128x256xf16>,
+                              %b: !cudnn.tensor<1x256x512xf16>,
+                              %bias: !cudnn.tensor<1x1x512xf16>)
+                                -> !cudnn.tensor<4x128x512xf16> {
+  %0 = cudnn.matmul(%a, %b) type = f32
+       : !cudnn.tensor<4x128x256xf16>, !cudnn.tensor<1x256x512xf16>
+         -> !cudnn.tensor<4x128x512xf16>
+  %1 = cudnn.pointwise_add(%0, %bias) type = f32
+       : !cudnn.tensor<4x128x512xf16>, !cudnn.tensor<1x1x512xf16>
+         -> !cudnn.tensor<4x128x512xf16>
+  %2 = cudnn.pointwise_gelu(%1) type = f32
+       : !cudnn.tensor<4x128x512xf16> -> !cudnn.tensor<4x128x512xf16>
+  cudnn.return %2 : !cudnn.tensor<4x128x512xf16>
+}
+
+// CHECK: cudnn.graph @matmul_bias_gelu
+// CHECK:   cudnn.matmul
+// CHECK:   cudnn.pointwise_add
+// CHECK:   cudnn.pointwise_gelu
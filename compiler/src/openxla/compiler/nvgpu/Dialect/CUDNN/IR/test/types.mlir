@@ -7,6 +7,11 @@ func.func @opaque(%arg0: !cudnn.tensor) {
   return
 }
 
+// CHECK: @executable(%arg0: !cudnn.executable)
+func.func @executable(%arg0: !cudnn.executable) {
+  return
+}
+
 // CHECK: @rank0(%arg0: !cudnn.tensor<?x?x?xf32>)
 func.func @rank0(%arg0: !cudnn.tensor<?x?x?xf32>) {
   return
@@ -32,3 +37,8 @@ func.func @strided(
 ) {
   return
 }
+
+// CHECK: @list(%arg0: !util.list<!cudnn.tensor>)
+func.func @list(%arg0: !util.list<!cudnn.tensor>) {
+  return
+}
@@ -6,6 +6,7 @@
 
 #include "iree/compiler/PluginAPI/Client.h"
 #include "mlir/Pass/Pass.h"
+#include "mlir/Pass/PassManager.h"
 #include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNDialect.h"
 #include "openxla/compiler/nvgpu/Transforms/Passes.h"
 
@@ -25,12 +26,19 @@ namespace {
 
 struct NvgpuOptions {
   bool flag = false;
+  bool enableCuDNN = false;
 
   void bindOptions(OptionsBinder &binder) {
     static llvm::cl::OptionCategory category("IREE Example Plugin");
     binder.opt<bool>("openxla-nvgpu-flag", flag,
                      llvm::cl::desc("Dummy flag for the nvgpu plugin"),
                      llvm::cl::cat(category));
+    binder.opt<bool>(
+        "openxla-nvgpu-enable-cudnn", enableCuDNN,
+        llvm::cl::desc("Offload StableHLO operations supported by cuDNN to "
+                       "cuDNN graphs executed by the cuDNN runtime module "
+                       "(cuDNN graphs are executed synchronously)"),
+        llvm::cl::cat(category));
   }
 };
 
@@ -40,6 +48,20 @@ struct NvgpuSession : public PluginSession<NvgpuSession, NvgpuOptions> {
   void onRegisterDialects(DialectRegistry &registry) override {
     registry.insert<openxla::compiler::nvgpu::cudnn::CUDNNDialect>();
   }
+
+  // cuDNN graphs are outlined from StableHLO before input conversion lowers it
+  // to Linalg, and are lowered to cuDNN runtime module calls right away, so
+  // the rest of the compilation pipeline never sees cuDNN operations.
+  void extendInputConversionPreprocessingPassPipeline(
+      OpPassManager &passManager,
+      InputDialectOptions::Type inputType) override {
+    if (!options.enableCuDNN)
+      return;
+    using namespace openxla::compiler::nvgpu;
+    passManager.addPass(createOutlineCUDNNGraphsPass());
+    passManager.addPass(createAssignCUDNNLayoutsPass());
+    passManager.addPass(createConvertCUDNNToRuntimePass());
+  }
 };
 
 } // namespace
@@ -0,0 +1,330 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <memory>
+#include <optional>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Sequence.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/SymbolTable.h"
+#include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNDialect.h"
+#include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNOps.h"
+#include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNTypes.h"
+#include "openxla/compiler/nvgpu/Transforms/Passes.h"
+#include "stablehlo/dialect/StablehloOps.h"
+
+#define GEN_PASS_DEF_ASSIGNCUDNNLAYOUTS
+#include "openxla/compiler/nvgpu/Transforms/Passes.h.inc"
+
+using namespace mlir;
+
+namespace openxla::compiler::nvgpu {
+
+// Physical layout of a cuDNN tensor defined as the order of logical dimensions
+// in memory (from the outermost to the innermost).
+using PhysicalOrder = SmallVector<unsigned>;
+
+//===----------------------------------------------------------------------===//
+// cuDNN tensor layouts.
+//===----------------------------------------------------------------------===//
+
+static PhysicalOrder getPhysicalOrder(cudnn::TensorType type) {
+  size_t rank = type.getShape().size();
+
+  if (auto layout = type.getLayout(); layout == cudnn::Layout::NHWC)
+    return {0, 2, 3, 1};
+
+  if (AffineMap strides = type.getStrides()) {
+    PhysicalOrder order(rank);
+    for (unsigned d = 0; d < rank; ++d) order[d] = strides.getDimPosition(d);
+    return order;
+  }
+
+  return llvm::to_vector(llvm::seq<unsigned>(0, rank));
+}
+
+// Returns the channels last layout (NHWC, NDHWC, KRSC for kernels) of a tensor
+// with logical dimensions ordered as NCHW (KCRS for kernels).
+static PhysicalOrder getChannelsLastOrder(size_t rank) {
+  PhysicalOrder order = {0};
+  for (unsigned d = 2; d < rank; ++d) order.push_back(d);
+  order.push_back(1);
+  return order;
+}
+
+// Returns a cuDNN tensor type with the same logical shape as `type` laid out
+// in memory in the given order. Uses one of the pre-defined layouts if
+// possible, and falls back on strides permutation map.
+static cudnn::TensorType getTensorType(cudnn::TensorType type,
+                                       ArrayRef<unsigned> order) {
+  ArrayRef<int64_t> shape = type.getShape();
+  Type element_type = type.getElementType();
+
+  if (order == ArrayRef<unsigned>({0, 1, 2, 3}))
+    return cudnn::TensorType::get(shape, element_type, cudnn::Layout::NCHW);
+  if (order == ArrayRef<unsigned>({0, 2, 3, 1}))
+    return cudnn::TensorType::get(shape, element_type, cudnn::Layout::NHWC);
+  if (llvm::is_sorted(order))
+    return cudnn::TensorType::get(shape, element_type);
+
+  return cudnn::TensorType::get(
+      shape, element_type,
+      AffineMap::getPermutationMap(order, type.getContext()));
+}
+
+// Returns a tensor type with the physical shape of the cuDNN tensor type.
+static RankedTensorType getPhysicalTensorType(cudnn::TensorType type,
+                                              ArrayRef<unsigned> order) {
+  SmallVector<int64_t> shape;
+  for (unsigned d : order) shape.push_back(type.getShape()[d]);
+  return RankedTensorType::get(shape, type.getElementType());
+}
+
+// Returns a permutation of physical dimensions transposing a tensor from the
+// `from` to the `to` layout (in the `stablehlo.transpose` convention).
+static SmallVector<int64_t> getTransposePermutation(ArrayRef<unsigned> from,
+                                                    ArrayRef<unsigned> to) {
+  SmallVector<int64_t> position(from.size());
+  for (auto [physical, logical] : llvm::enumerate(from))
+    position[logical] = physical;
+
+  SmallVector<int64_t> permutation;
+  for (unsigned logical : to) permutation.push_back(position[logical]);
+  return permutation;
+}
+
+//===----------------------------------------------------------------------===//
+// Choosing a layout for every cuDNN graph.
+//===----------------------------------------------------------------------===//
+
+// Returns all cuDNN tensor values defined in the graph.
+static SmallVector<Value> getGraphTensors(cudnn::GraphOp graph) {
+  Block& body = graph.getBody().front();
+  SmallVector<Value> tensors(body.getArguments());
+  for (Operation& op : body.without_terminator())
+    llvm::append_range(tensors, op.getResults());
+  return tensors;
+}
+
+// Returns the rank shared by all graph tensors, or std::nullopt if tensors of
+// different ranks can't be assigned the same layout.
+static std::optional<size_t> getGraphRank(cudnn::GraphOp graph) {
+  std::optional<size_t> rank;
+  for (Value tensor : getGraphTensors(graph)) {
+    auto type = tensor.getType().dyn_cast<cudnn::TensorType>();
+    if (!type) return std::nullopt;
+    size_t tensor_rank = type.getShape().size();
+    if (rank && *rank != tensor_rank) return std::nullopt;
+    rank = tensor_rank;
+  }
+  return rank;
+}
+
+// Tensor cores run convolutions natively in the channels last layout, and
+// cuDNN transposes inputs in NCHW layout inside its kernels (or falls back on
+// slower kernels). Returns true if the graph has a convolution with a data
+// type that is executed on tensor cores.
+static bool prefersChannelsLast(cudnn::GraphOp graph) {
+  auto is_tensor_core_conv = [](Operation* op) {
+    if (!isa<cudnn::ConvolutionOp, cudnn::CrossCorrelationOp>(op))
+      return false;
+    Type element_type =
+        op->getOperand(0).getType().cast<cudnn::TensorType>().getElementType();
+    return element_type.isF16() || element_type.isBF16() ||
+           element_type.isInteger(8);
+  };
+  return llvm::any_of(graph.getBody().front().without_terminator(),
+                      [&](Operation& op) { return is_tensor_core_conv(&op); });
+}
+
+static bool hasConvolution(cudnn::GraphOp graph) {
+  return llvm::any_of(
+      graph.getBody().front().without_terminator(), [](Operation& op) {
+        return isa<cudnn::ConvolutionOp, cudnn::CrossCorrelationOp>(op);
+      });
+}
+
+// Chooses layouts for all graphs in the order of their first calls, so that
+// graphs without convolutions (pointwise only) can follow the layout of the
+// graphs producing their arguments, and don't need any transposes.
+static DenseMap<cudnn::GraphOp, PhysicalOrder> chooseLayouts(
+    ModuleOp module, SymbolTable& symbol_table) {
+  DenseMap<cudnn::GraphOp, PhysicalOrder> layouts;
+
+  module.walk([&](cudnn::CallOp call) {
+    auto graph = symbol_table.lookup<cudnn::GraphOp>(call.getCallee());
+    if (!graph || layouts.count(graph)) return;
+
+    std::optional<size_t> rank = getGraphRank(graph);
+    if (!rank) return;
+
+    if (prefersChannelsLast(graph)) {
+      layouts[graph] = getChannelsLastOrder(*rank);
+      return;
+    }
+
+    // Convolutions with other data types keep the original layout.
+    if (hasConvolution(graph)) return;
+
+    for (Value operand : call.getOperands()) {
+      auto producer = operand.getDefiningOp<cudnn::CallOp>();
+      if (!producer) continue;
+
+      auto it = layouts.find(
+          symbol_table.lookup<cudnn::GraphOp>(producer.getCallee()));
+      if (it == layouts.end() || it->second.size() != *rank) continue;
+
+      layouts[graph] = it->second;
+      return;
+    }
+  });
+
+  return layouts;
+}
+
+//===----------------------------------------------------------------------===//
+// Rewriting cuDNN graphs and calls to the assigned layouts.
+//===----------------------------------------------------------------------===//
+
+// Updates all graph tensors to the layout `order`. Returns false if the graph
+// already has the requested layout.
+static bool updateGraphLayout(cudnn::GraphOp graph, ArrayRef<unsigned> order) {
+  bool changed = false;
+  for (Value tensor : getGraphTensors(graph)) {
+    auto type = tensor.getType().cast<cudnn::TensorType>();
+    if (getPhysicalOrder(type) == order) continue;
+    tensor.setType(getTensorType(type, order));
+    changed = true;
+  }
+
+  if (!changed) return false;
+
+  Block& body = graph.getBody().front();
+  graph.setFunctionType(FunctionType::get(
+      graph.getContext(), body.getArgumentTypes(),
+      body.getTerminator()->getOperandTypes()));
+  return true;
+}
+
+static Value transpose(OpBuilder& b, Location loc, Value value,
+                       cudnn::TensorType type, ArrayRef<unsigned> from,
+                       ArrayRef<unsigned> to) {
+  if (from == to) return value;
+  return b.create<stablehlo::TransposeOp>(
+      loc, getPhysicalTensorType(type, to), value,
+      b.getI64TensorAttr(getTransposePermutation(from, to)));
+}
+
+// Inserts transposes at the call boundary to pass arguments and results in
+// the original layouts to the graph with updated layouts.
+static void updateCall(cudnn::CallOp call, cudnn::GraphOp graph,
+                       ArrayRef<PhysicalOrder> arg_orders,
+                       ArrayRef<PhysicalOrder> result_orders) {
+  OpBuilder b(call);
+  Location loc = call.getLoc();
+
+  for (auto [index, type] : llvm::enumerate(graph.getArgumentTypes())) {
+    auto tensor_type = type.cast<cudnn::TensorType>();
+    call->setOperand(index, transpose(b, loc, call.getOperand(index),
+                                      tensor_type, arg_orders[index],
+                                      getPhysicalOrder(tensor_type)));
+  }
+
+  b.setInsertionPointAfter(call);
+  for (auto [index, type] : llvm::enumerate(graph.getResultTypes())) {
+    auto tensor_type = type.cast<cudnn::TensorType>();
+    PhysicalOrder order = getPhysicalOrder(tensor_type);
+    if (order == result_orders[index]) continue;
+
+    Value result = call.getResult(index);
+    result.setType(getPhysicalTensorType(tensor_type, order));
+    Value transposed =
+        transpose(b, loc, result, tensor_type, order, result_orders[index]);
+    result.replaceAllUsesExcept(transposed, transposed.getDefiningOp());
+  }
+}
+
+// Folds back-to-back transposes created at the boundaries of adjacent cuDNN
+// calls into a single transpose (or removes them if they cancel each other).
+static void foldTransposes(ModuleOp module) {
+  SmallVector<stablehlo::TransposeOp> transposes;
+  module.walk([&](stablehlo::TransposeOp op) { transposes.push_back(op); });
+
+  for (stablehlo::TransposeOp op : transposes) {
+    auto producer = op.getOperand().getDefiningOp<stablehlo::TransposeOp>();
+    if (!producer) continue;
+
+    auto inner = producer.getPermutation().getValues<int64_t>();
+    SmallVector<int64_t> permutation;
+    for (int64_t d : op.getPermutation().getValues<int64_t>())
+      permutation.push_back(inner[d]);
+
+    OpBuilder b(op);
+    Value folded = producer.getOperand();
+    if (!llvm::equal(permutation, llvm::seq<int64_t>(0, permutation.size())))
+      folded = b.create<stablehlo::TransposeOp>(
+          op.getLoc(), op.getType(), folded,
+          b.getI64TensorAttr(permutation));
+
+    op.replaceAllUsesWith(folded);
+    op.erase();
+    if (producer.use_empty()) producer.erase();
+  }
+}
+
+namespace {
+
+class AssignCUDNNLayouts
+    : public ::impl::AssignCUDNNLayoutsBase<AssignCUDNNLayouts> {
+ public:
+  void runOnOperation() override {
+    ModuleOp module = getOperation();
+    SymbolTable symbol_table(module);
+
+    // Physical layouts of graph arguments and results at the call sites
+    // before layout assignment.
+    struct CallLayouts {
+      SmallVector<PhysicalOrder> args;
+      SmallVector<PhysicalOrder> results;
+    };
+
+    auto get_orders = [](ArrayRef<Type> types) {
+      SmallVector<PhysicalOrder> orders;
+      for (Type type : types)
+        orders.push_back(getPhysicalOrder(type.cast<cudnn::TensorType>()));
+      return orders;
+    };
+
+    DenseMap<cudnn::GraphOp, CallLayouts> updated;
+    for (auto& [graph, order] : chooseLayouts(module, symbol_table)) {
+      CallLayouts layouts = {get_orders(graph.getArgumentTypes()),
+                             get_orders(graph.getResultTypes())};
+      if (updateGraphLayout(graph, order))
+        updated[graph] = std::move(layouts);
+    }
+
+    module.walk([&](cudnn::CallOp call) {
+      auto graph = symbol_table.lookup<cudnn::GraphOp>(call.getCallee());
+      auto it = updated.find(graph);
+      if (it == updated.end()) return;
+      updateCall(call, graph, it->second.args, it->second.results);
+    });
+
+    foldTransposes(module);
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> createAssignCUDNNLayoutsPass() {
+  return std::make_unique<AssignCUDNNLayouts>();
+}
+
+} // namespace openxla::compiler::nvgpu
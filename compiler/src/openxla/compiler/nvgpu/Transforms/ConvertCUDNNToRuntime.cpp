@@ -0,0 +1,703 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
+
+#include "iree/compiler/Dialect/HAL/IR/HALDialect.h"
+#include "iree/compiler/Dialect/HAL/IR/HALOps.h"
+#include "iree/compiler/Dialect/HAL/IR/HALTypes.h"
+#include "iree/compiler/Dialect/Util/IR/UtilDialect.h"
+#include "iree/compiler/Dialect/Util/IR/UtilOps.h"
+#include "iree/compiler/Dialect/Util/IR/UtilTypes.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Sequence.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/TypeSwitch.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/SymbolTable.h"
+#include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNDialect.h"
+#include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNOps.h"
+#include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNTypes.h"
+#include "openxla/compiler/nvgpu/Transforms/Passes.h"
+#include "stablehlo/dialect/StablehloOps.h"
+
+#define GEN_PASS_DEF_CONVERTCUDNNTORUNTIME
+#include "openxla/compiler/nvgpu/Transforms/Passes.h.inc"
+
+using namespace mlir;
+
+namespace IREE = mlir::iree_compiler::IREE;
+
+namespace openxla::compiler::nvgpu {
+
+// Alignment (in bytes) of the HAL buffer bindings: IREE allocates buffers and
+// sub-allocates tensors from them (subspan offsets) with at least this
+// alignment. It's also the largest alignment that cuDNN engines can take
+// advantage of (vectorized 16-byte memory accesses).
+static constexpr int64_t kBufferAlignment = 16;
+
+// Executables compiled by the cuDNN runtime module use module-wide workspace
+// limit when the graph limit is negative.
+static constexpr int64_t kDefaultWorkspaceLimit = -1;
+
+//===----------------------------------------------------------------------===//
+// cuDNN tensor types to the runtime tensor descriptors.
+//===----------------------------------------------------------------------===//
+
+// Returns cuDNN data type (`cudnnDataType_t` enum value) for the element type.
+static std::optional<int64_t> getCudnnDataType(Type type) {
+  if (type.isF32()) return 0;         // CUDNN_DATA_FLOAT
+  if (type.isF64()) return 1;         // CUDNN_DATA_DOUBLE
+  if (type.isF16()) return 2;         // CUDNN_DATA_HALF
+  if (type.isInteger(8)) return 3;    // CUDNN_DATA_INT8
+  if (type.isInteger(32)) return 4;   // CUDNN_DATA_INT32
+  if (type.isBF16()) return 9;        // CUDNN_DATA_BFLOAT16
+  if (type.isInteger(64)) return 10;  // CUDNN_DATA_INT64
+  if (type.isInteger(1)) return 11;   // CUDNN_DATA_BOOLEAN
+  return std::nullopt;
+}
+
+// Returns logical dimensions in the order they are laid out in memory (from
+// the outermost to the innermost).
+static SmallVector<unsigned> getPhysicalOrder(cudnn::TensorType type) {
+  size_t rank = type.getShape().size();
+
+  if (auto layout = type.getLayout(); layout == cudnn::Layout::NHWC)
+    return {0, 2, 3, 1};
+
+  if (AffineMap strides = type.getStrides()) {
+    SmallVector<unsigned> order(rank);
+    for (unsigned d = 0; d < rank; ++d) order[d] = strides.getDimPosition(d);
+    return order;
+  }
+
+  return llvm::to_vector(llvm::seq<unsigned>(0, rank));
+}
+
+// Returns a tensor type with the same physical layout as the cuDNN tensor.
+static RankedTensorType getPhysicalTensorType(cudnn::TensorType type) {
+  SmallVector<int64_t> shape;
+  for (unsigned d : getPhysicalOrder(type)) shape.push_back(type.getShape()[d]);
+  return RankedTensorType::get(shape, type.getElementType());
+}
+
+static bool isDynamic(cudnn::TensorType type) {
+  return llvm::any_of(type.getShape(), ShapedType::isDynamic);
+}
+
+//===----------------------------------------------------------------------===//
+// Tensor alignment analysis.
+//===----------------------------------------------------------------------===//
+
+// Returns alignment (in bytes) guaranteed for the device memory holding the
+// tensor value. Tensors produced by the program are allocated by IREE in HAL
+// buffers aligned to `kBufferAlignment`, and slices of other tensors are bound
+// to subspans at the slice offset. Function arguments (and imported tensors)
+// can be bound to buffer views at any offset chosen by the caller, and are
+// only known to be element aligned.
+static int64_t getTensorAlignment(Value tensor) {
+  int64_t element_size = llvm::divideCeil(
+      cast<ShapedType>(tensor.getType()).getElementTypeBitWidth(), 8);
+
+  if (isa<BlockArgument>(tensor) ||
+      tensor.getDefiningOp<IREE::HAL::TensorImportOp>())
+    return element_size;
+
+  // Reshapes and casts do not move tensor data, and have the source alignment.
+  Operation* op = tensor.getDefiningOp();
+  if (isa<tensor::CastOp, tensor::BitcastOp, tensor::ReshapeOp,
+          tensor::CollapseShapeOp, tensor::ExpandShapeOp,
+          stablehlo::ReshapeOp>(op))
+    return getTensorAlignment(op->getOperand(0));
+
+  auto slice = dyn_cast<tensor::ExtractSliceOp>(op);
+  if (!slice) return kBufferAlignment;
+
+  int64_t source_alignment = getTensorAlignment(slice.getSource());
+  RankedTensorType source_type = slice.getSourceType();
+
+  // With dynamic offsets we only know that the slice is element aligned.
+  if (!source_type.hasStaticShape() ||
+      llvm::any_of(slice.getStaticOffsets(), ShapedType::isDynamic))
+    return std::min(source_alignment, element_size);
+
+  // Byte offset of the first slice element in the row major source tensor.
+  int64_t offset = 0;
+  for (auto [dim, index] :
+       llvm::zip(source_type.getShape(), slice.getStaticOffsets()))
+    offset = offset * dim + index;
+  offset *= element_size;
+
+  return offset == 0 ? source_alignment : std::gcd(source_alignment, offset);
+}
+
+// Returns alignments of the cuDNN graph arguments guaranteed at all call sites.
+static llvm::StringMap<SmallVector<int64_t>> getArgumentAlignments(
+    ModuleOp module) {
+  llvm::StringMap<SmallVector<int64_t>> alignments;
+  module.walk([&](cudnn::CallOp call) {
+    auto [it, inserted] = alignments.try_emplace(
+        call.getCallee(),
+        SmallVector<int64_t>(call.getNumOperands(), kBufferAlignment));
+    for (auto [alignment, operand] : llvm::zip(it->second, call.getOperands()))
+      alignment = std::min(alignment, getTensorAlignment(operand));
+  });
+  return alignments;
+}
+
+//===----------------------------------------------------------------------===//
+// cuDNN runtime module API.
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+// Declarations of the cuDNN runtime module functions imported into the module.
+class RuntimeApi {
+ public:
+  RuntimeApi(ModuleOp module, SymbolTable& symbol_table)
+      : module_(module), symbol_table_(symbol_table) {}
+
+  func::CallOp call(OpBuilder& b, Location loc, StringRef name,
+                    TypeRange results, ValueRange args) {
+    func::FuncOp callee = getOrInsert(
+        name, FunctionType::get(b.getContext(), args.getTypes(), results));
+    return b.create<func::CallOp>(loc, callee, args);
+  }
+
+ private:
+  func::FuncOp getOrInsert(StringRef name, FunctionType type) {
+    if (auto func = symbol_table_.lookup<func::FuncOp>(name)) return func;
+
+    auto b = OpBuilder::atBlockBegin(module_.getBody());
+    auto func = b.create<func::FuncOp>(module_.getLoc(), name, type);
+    func.setPrivate();
+    symbol_table_.insert(func);
+    return func;
+  }
+
+  ModuleOp module_;
+  SymbolTable& symbol_table_;
+};
+
+// cuDNN graph lowered to the runtime module API calls.
+struct LoweredGraph {
+  cudnn::GraphOp graph;
+
+  // Global holding the cuDNN executable built by the module initializer, for
+  // graphs with static shapes.
+  IREE::Util::GlobalOp executable;
+
+  // Function building the cuDNN executable for concrete values of dynamic
+  // dimensions, for graphs with dynamic shapes. Built executables are memoized
+  // at run time by the graph `key` and dynamic dimensions.
+  func::FuncOp build;
+  int64_t key = 0;
+
+  // Indices of graph arguments bound to device memory at run time (unused
+  // arguments are not a part of the cuDNN operation graph).
+  SmallVector<unsigned> args;
+};
+
+} // namespace
+
+static Value createList(OpBuilder& b, Location loc, Type element_type,
+                        ValueRange values) {
+  auto list_type = IREE::Util::ListType::get(element_type);
+  Value size = b.create<arith::ConstantIndexOp>(loc, values.size());
+  Value list = b.create<IREE::Util::ListCreateOp>(loc, list_type, size);
+  b.create<IREE::Util::ListResizeOp>(loc, list, size);
+  for (auto [index, value] : llvm::enumerate(values)) {
+    b.create<IREE::Util::ListSetOp>(
+        loc, list, b.create<arith::ConstantIndexOp>(loc, index), value);
+  }
+  return list;
+}
+
+// Returns a key identifying the graph structure (and arguments alignment) at
+// run time. Graphs compiled separately share memoized executables only if they
+// are identical.
+static int64_t getGraphKey(cudnn::GraphOp graph,
+                           ArrayRef<int64_t> arg_alignments) {
+  std::string str;
+  llvm::raw_string_ostream os(str);
+  graph->print(os, OpPrintingFlags().useLocalScope());
+  for (int64_t alignment : arg_alignments) os << " " << alignment;
+  return static_cast<int64_t>(llvm::xxHash64(os.str()));
+}
+
+//===----------------------------------------------------------------------===//
+// Lowering cudnn.graph to the runtime module API calls.
+//===----------------------------------------------------------------------===//
+
+// Emits runtime module API calls building a cuDNN executable from the graph,
+// with `arg_dims` defining logical dimensions (i64 values) of graph arguments.
+// The graph result is bound to a buffer allocated by the call lowering, and
+// always has the HAL buffer alignment.
+static FailureOr<Value> buildExecutable(OpBuilder& b, Location loc,
+                                        cudnn::GraphOp graph,
+                                        ArrayRef<SmallVector<Value>> arg_dims,
+                                        ArrayRef<int64_t> arg_alignments,
+                                        RuntimeApi& api) {
+  MLIRContext* ctx = b.getContext();
+  Block& body = graph.getBody().front();
+  auto tensor = cudnn::TensorType::get(ctx);
+
+  auto constant = [&](int64_t value) -> Value {
+    return b.create<arith::ConstantIntOp>(loc, value, 64);
+  };
+  auto f32_constant = [&](APFloat value) -> Value {
+    return b.create<arith::ConstantFloatOp>(loc, value, b.getF32Type());
+  };
+  auto list = [&](ArrayRef<int64_t> values) -> Value {
+    return createList(b, loc, b.getI64Type(),
+                      llvm::to_vector(llvm::map_range(values, constant)));
+  };
+  Value alignment = constant(kBufferAlignment);
+
+  // Tensor UIDs are assigned to graph arguments first, and then to operation
+  // results. Runtime binds arguments and the result to device memory in this
+  // order, and replaces intermediate results with virtual tensors.
+  int64_t uid = 0;
+  DenseMap<Value, Value> mapping;
+
+  // Lowers convolution of the given `cudnnConvolutionMode_t` mode.
+  auto convolution = [&](auto conv, int64_t mode, Value op_uid) -> Value {
+    return api
+        .call(b, loc, "cudnn.convolution", tensor,
+              {mapping[conv.getX()], mapping[conv.getW()], constant(mode),
+               f32_constant(conv.getAlpha()), f32_constant(conv.getBeta()),
+               list(conv.getSpatialStride()), list(conv.getPrePadding()),
+               list(conv.getPostPadding()), list(conv.getDilation()), op_uid,
+               alignment, b.create<arith::ConstantIntOp>(loc, 0, 32)})
+        .getResult(0);
+  };
+
+  for (BlockArgument arg : body.getArguments()) {
+    int64_t arg_uid = uid++;
+    if (arg.use_empty()) continue;
+
+    auto type = arg.getType().cast<cudnn::TensorType>();
+    auto dtype = getCudnnDataType(type.getElementType());
+    if (!dtype)
+      return graph.emitError() << "unsupported cuDNN tensor element type "
+                               << type.getElementType();
+
+    // Strides of a dense tensor with logical dimensions laid out in memory in
+    // the physical order.
+    ArrayRef<Value> dims = arg_dims[arg.getArgNumber()];
+    SmallVector<Value> strides(dims.size());
+    Value stride = constant(1);
+    for (unsigned d : llvm::reverse(getPhysicalOrder(type))) {
+      strides[d] = stride;
+      stride = b.create<arith::MulIOp>(loc, stride, dims[d]);
+    }
+
+    mapping[arg] = api.call(b, loc, "cudnn.tensor.arg.strided", tensor,
+                            {constant(*dtype),
+                             createList(b, loc, b.getI64Type(), dims),
+                             createList(b, loc, b.getI64Type(), strides),
+                             constant(arg_uid),
+                             constant(arg_alignments[arg.getArgNumber()])})
+                       .getResult(0);
+  }
+
+  for (Operation& op : body.without_terminator()) {
+    Value op_uid = constant(uid++);
+
+    auto result = TypeSwitch<Operation*, FailureOr<Value>>(&op)
+        .Case<cudnn::PointWiseAddOp>([&](auto add) -> FailureOr<Value> {
+          return api.call(b, loc, "cudnn.pointwise_add", tensor,
+                          {mapping[add.getLhs()], mapping[add.getRhs()],
+                           op_uid, alignment})
+              .getResult(0);
+        })
+        .Case<cudnn::PointWiseReluOp>([&](auto relu) -> FailureOr<Value> {
+          double lower_clip = relu.getLowerClip().convertToDouble();
+          Value lower = b.create<arith::ConstantFloatOp>(
+              loc, APFloat(static_cast<float>(lower_clip)), b.getF32Type());
+          Value upper = b.create<arith::ConstantFloatOp>(
+              loc, APFloat(std::numeric_limits<float>::infinity()),
+              b.getF32Type());
+          return api.call(b, loc, "cudnn.pointwise_relu", tensor,
+                          {mapping[relu.getInput()], lower, upper, op_uid,
+                           alignment})
+              .getResult(0);
+        })
+        .Case<cudnn::PointWiseGeluOp>([&](auto gelu) -> FailureOr<Value> {
+          return api.call(b, loc, "cudnn.pointwise_gelu", tensor,
+                          {mapping[gelu.getInput()], op_uid, alignment})
+              .getResult(0);
+        })
+        .Case<cudnn::MatMulOp>([&](auto matmul) -> FailureOr<Value> {
+          return api.call(b, loc, "cudnn.matmul", tensor,
+                          {mapping[matmul.getA()], mapping[matmul.getB()],
+                           op_uid, alignment})
+              .getResult(0);
+        })
+        .Case<cudnn::ConvolutionOp>([&](auto conv) -> FailureOr<Value> {
+          return convolution(conv, /*CUDNN_CONVOLUTION=*/0, op_uid);
+        })
+        .Case<cudnn::CrossCorrelationOp>([&](auto conv) -> FailureOr<Value> {
+          return convolution(conv, /*CUDNN_CROSS_CORRELATION=*/1, op_uid);
+        })
+        .Default([&](Operation* op) -> FailureOr<Value> {
+          return op->emitError()
+                 << "is not supported by the cuDNN runtime module";
+        });
+    if (failed(result)) return failure();
+    mapping[op.getResult(0)] = *result;
+  }
+
+  // Build an operation graph and compile it to an executable.
+  Value operation_graph =
+      api.call(b, loc, "cudnn.graph.create",
+               cudnn::OperationGraphType::get(ctx),
+               {mapping[body.getTerminator()->getOperand(0)]})
+          .getResult(0);
+  return api
+      .call(b, loc, "cudnn.graph.compile", cudnn::ExecutableType::get(ctx),
+            {operation_graph, constant(kDefaultWorkspaceLimit)})
+      .getResult(0);
+}
+
+static FailureOr<LoweredGraph> lowerGraph(cudnn::GraphOp graph,
+                                          ArrayRef<int64_t> arg_alignments,
+                                          RuntimeApi& api,
+                                          SymbolTable& symbol_table) {
+  MLIRContext* ctx = graph.getContext();
+  Location loc = graph.getLoc();
+  Block& body = graph.getBody().front();
+
+  auto returned = cast<cudnn::ReturnOp>(body.getTerminator());
+  if (returned.getNumOperands() != 1 ||
+      !returned.getOperand(0).getDefiningOp())
+    return graph.emitError() << "cuDNN graph must return an operation result";
+
+  LoweredGraph lowered;
+  lowered.graph = graph;
+
+  for (BlockArgument arg : body.getArguments())
+    if (!arg.use_empty()) lowered.args.push_back(arg.getArgNumber());
+
+  auto executable_type = cudnn::ExecutableType::get(ctx);
+  auto arg_types = llvm::to_vector(
+      llvm::map_range(graph.getArgumentTypes(), [](Type type) {
+        return type.cast<cudnn::TensorType>();
+      }));
+
+  OpBuilder builder(graph);
+  SmallVector<SmallVector<Value>> arg_dims;
+
+  // Graphs with static shapes are built once by the module initializer, and
+  // the executable is cached in a global.
+  if (llvm::none_of(arg_types, isDynamic)) {
+    lowered.executable = builder.create<IREE::Util::GlobalOp>(
+        loc, (graph.getName() + ".executable").str(), /*isMutable=*/false,
+        executable_type);
+    lowered.executable.setPrivate();
+    symbol_table.insert(lowered.executable);
+
+    auto initializer = builder.create<IREE::Util::InitializerOp>(loc);
+    OpBuilder b = OpBuilder::atBlockBegin(initializer.addEntryBlock());
+
+    for (cudnn::TensorType type : arg_types) {
+      auto& dims = arg_dims.emplace_back();
+      for (int64_t dim : type.getShape())
+        dims.push_back(b.create<arith::ConstantIntOp>(loc, dim, 64));
+    }
+
+    auto executable = buildExecutable(b, loc, graph, arg_dims,
+                                      arg_alignments, api);
+    if (failed(executable)) return failure();
+
+    b.create<IREE::Util::GlobalStoreOp>(loc, *executable,
+                                        lowered.executable.getSymName());
+    b.create<IREE::Util::InitializerReturnOp>(loc);
+    return lowered;
+  }
+
+  // Graphs with dynamic shapes are built by a function taking concrete values
+  // of all dynamic dimensions, and executables are memoized at run time.
+  auto shape_type = IREE::Util::ListType::get(builder.getI64Type());
+  lowered.key = getGraphKey(graph, arg_alignments);
+  lowered.build = builder.create<func::FuncOp>(
+      loc, (graph.getName() + ".build").str(),
+      FunctionType::get(ctx, shape_type, executable_type));
+  lowered.build.setPrivate();
+  symbol_table.insert(lowered.build);
+
+  OpBuilder b = OpBuilder::atBlockBegin(lowered.build.addEntryBlock());
+  Value shape = lowered.build.getArgument(0);
+
+  int64_t num_dynamic_dims = 0;
+  for (cudnn::TensorType type : arg_types) {
+    auto& dims = arg_dims.emplace_back();
+    for (int64_t dim : type.getShape()) {
+      if (!ShapedType::isDynamic(dim)) {
+        dims.push_back(b.create<arith::ConstantIntOp>(loc, dim, 64));
+        continue;
+      }
+      Value index = b.create<arith::ConstantIndexOp>(loc, num_dynamic_dims++);
+      dims.push_back(b.create<IREE::Util::ListGetOp>(loc, b.getI64Type(),
+                                                     shape, index));
+    }
+  }
+
+  auto executable = buildExecutable(b, loc, graph, arg_dims,
+                                      arg_alignments, api);
+  if (failed(executable)) return failure();
+  b.create<func::ReturnOp>(loc, *executable);
+
+  return lowered;
+}
+
+//===----------------------------------------------------------------------===//
+// Lowering cudnn.call to the cuDNN executable execution.
+//===----------------------------------------------------------------------===//
+
+// Returns an executable memoized for the dynamic dimensions, or builds a new
+// one if it is the first call with these dimensions.
+static Value getMemoizedExecutable(OpBuilder& b, Location loc,
+                                   const LoweredGraph& lowered,
+                                   ValueRange dynamic_dims, RuntimeApi& api) {
+  Type executable_type = cudnn::ExecutableType::get(b.getContext());
+
+  SmallVector<Value> dims;
+  for (Value dim : dynamic_dims)
+    dims.push_back(b.create<arith::IndexCastOp>(loc, b.getI64Type(), dim));
+  Value shape = createList(b, loc, b.getI64Type(), dims);
+  Value key = b.create<arith::ConstantIntOp>(loc, lowered.key, 64);
+
+  auto lookup = api.call(b, loc, "cudnn.executable.lookup",
+                         {b.getI32Type(), executable_type}, {key, shape});
+  Value found =
+      b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::ne,
+                              lookup.getResult(0),
+                              b.create<arith::ConstantIntOp>(loc, 0, 32));
+
+  auto memoized = b.create<scf::IfOp>(
+      loc, found,
+      [&](OpBuilder& b, Location loc) {
+        b.create<scf::YieldOp>(loc, lookup.getResult(1));
+      },
+      [&](OpBuilder& b, Location loc) {
+        Value built =
+            b.create<func::CallOp>(loc, lowered.build, shape).getResult(0);
+        api.call(b, loc, "cudnn.executable.memoize", TypeRange(),
+                 {key, shape, built});
+        b.create<scf::YieldOp>(loc, built);
+      });
+  return memoized.getResult(0);
+}
+
+// Returns dynamic dimensions of the convolution result [N, K, (D,) H, W] for
+// the input [N, C, (D,) H, W] and filter [K, C / groups, (D,) H, W] dimensions.
+template <typename ConvOp>
+static SmallVector<Value> getConvolutionDims(
+    OpBuilder& b, Location loc, ConvOp conv,
+    DenseMap<Value, SmallVector<Value>>& dims) {
+  auto result_type = conv.getY().getType().template cast<cudnn::TensorType>();
+  auto x_type = conv.getX().getType().template cast<cudnn::TensorType>();
+  auto w_type = conv.getW().getType().template cast<cudnn::TensorType>();
+  SmallVector<Value> x_dims = dims[conv.getX()];
+  SmallVector<Value> w_dims = dims[conv.getW()];
+
+  // Returns logical dimension as an index value.
+  auto get_dim = [&](cudnn::TensorType type, ArrayRef<Value> logical,
+                     unsigned d) -> Value {
+    if (logical[d]) return logical[d];
+    return b.create<arith::ConstantIndexOp>(loc, type.getShape()[d]);
+  };
+  auto constant = [&](int64_t value) -> Value {
+    return b.create<arith::ConstantIndexOp>(loc, value);
+  };
+
+  SmallVector<Value> result_dims(result_type.getShape().size());
+  for (unsigned d = 0; d < result_dims.size(); ++d) {
+    if (!ShapedType::isDynamic(result_type.getShape()[d])) continue;
+    if (d == 0) {
+      result_dims[d] = get_dim(x_type, x_dims, 0);
+      continue;
+    }
+    if (d == 1) {
+      result_dims[d] = get_dim(w_type, w_dims, 0);
+      continue;
+    }
+
+    // (x + pre + post - (dilation * (w - 1) + 1)) / stride + 1
+    unsigned s = d - 2;
+    Value padded = b.create<arith::AddIOp>(
+        loc, get_dim(x_type, x_dims, d),
+        constant(conv.getPrePadding()[s] + conv.getPostPadding()[s]));
+    Value window = b.create<arith::AddIOp>(
+        loc,
+        b.create<arith::MulIOp>(
+            loc, constant(conv.getDilation()[s]),
+            b.create<arith::SubIOp>(loc, get_dim(w_type, w_dims, d),
+                                    constant(1))),
+        constant(1));
+    Value strided = b.create<arith::DivUIOp>(
+        loc, b.create<arith::SubIOp>(loc, padded, window),
+        constant(conv.getSpatialStride()[s]));
+    result_dims[d] = b.create<arith::AddIOp>(loc, strided, constant(1));
+  }
+  return result_dims;
+}
+
+static void lowerCall(cudnn::CallOp call, const LoweredGraph& lowered,
+                      RuntimeApi& api) {
+  MLIRContext* ctx = call.getContext();
+  Location loc = call.getLoc();
+  Block& body = lowered.graph.getBody().front();
+  OpBuilder b(call);
+
+  // Dynamic logical dimensions (index values) of graph tensors at the call
+  // site (null for static dimensions). Results of pointwise operations have
+  // the same dimensions as their first operand, matmul results [batch, m, n]
+  // take dimensions from `a` [batch, m, k] and `b` [batch, k, n], and
+  // convolution results are computed from the input and filter dimensions.
+  DenseMap<Value, SmallVector<Value>> dims;
+  SmallVector<Value> dynamic_dims;
+  for (BlockArgument arg : body.getArguments()) {
+    auto type = arg.getType().cast<cudnn::TensorType>();
+    auto& arg_dims = dims[arg];
+    arg_dims.resize(type.getShape().size());
+    for (auto [physical, logical] : llvm::enumerate(getPhysicalOrder(type))) {
+      if (!ShapedType::isDynamic(type.getShape()[logical])) continue;
+      arg_dims[logical] = b.create<tensor::DimOp>(
+          loc, call.getOperand(arg.getArgNumber()), physical);
+    }
+    for (Value dim : arg_dims)
+      if (dim) dynamic_dims.push_back(dim);
+  }
+  for (Operation& op : body.without_terminator()) {
+    // Copy dimensions before inserting the result, which can grow the map.
+    SmallVector<Value> result_dims = dims[op.getOperand(0)];
+    if (auto matmul = dyn_cast<cudnn::MatMulOp>(op))
+      result_dims[2] = dims[matmul.getB()][2];
+    if (auto conv = dyn_cast<cudnn::ConvolutionOp>(op))
+      result_dims = getConvolutionDims(b, loc, conv, dims);
+    if (auto conv = dyn_cast<cudnn::CrossCorrelationOp>(op))
+      result_dims = getConvolutionDims(b, loc, conv, dims);
+    dims[op.getResult(0)] = std::move(result_dims);
+  }
+
+  // Returns dynamic dimensions of the graph tensor in the physical order.
+  auto get_dynamic_sizes = [&](Value value) {
+    auto type = value.getType().cast<cudnn::TensorType>();
+    SmallVector<Value> sizes;
+    for (unsigned d : getPhysicalOrder(type))
+      if (Value dim = dims[value][d]) sizes.push_back(dim);
+    return sizes;
+  };
+
+  auto buffer_view = IREE::HAL::BufferViewType::get(ctx);
+  auto export_tensor = [&](Value tensor) -> Value {
+    return b.create<IREE::HAL::TensorExportOp>(
+        loc, buffer_view, tensor, TypeAttr::get(tensor.getType()),
+        /*name=*/nullptr);
+  };
+  auto allocate = [&](Value value) -> Value {
+    RankedTensorType type =
+        getPhysicalTensorType(value.getType().cast<cudnn::TensorType>());
+    return b.create<tensor::EmptyOp>(loc, type.getShape(),
+                                     type.getElementType(),
+                                     get_dynamic_sizes(value));
+  };
+
+  // Tensors bound to the graph in the UID order: arguments and then the
+  // result written by cuDNN. Intermediate tensors are virtual (the runtime
+  // graph builder keeps them in on-chip memory), and are never allocated.
+  SmallVector<Value> tensors;
+  for (unsigned arg : lowered.args) tensors.push_back(call.getOperand(arg));
+
+  Value returned = body.getTerminator()->getOperand(0);
+  tensors.push_back(allocate(returned));
+
+  SmallVector<Value> buffers;
+  for (Value tensor : tensors) buffers.push_back(export_tensor(tensor));
+  Value result = buffers.back();
+
+  Value list = createList(b, loc, buffer_view, buffers);
+
+  Value executable =
+      lowered.executable
+          ? b.create<IREE::Util::GlobalLoadOp>(
+                 loc, lowered.executable.getType(),
+                 lowered.executable.getSymName())
+                .getResult()
+          : getMemoizedExecutable(b, loc, lowered, dynamic_dims, api);
+  // cuDNN graph execution is synchronous: exported tensors are ready when
+  // the call starts, and the result is written when the call returns. CUDA HAL
+  // does not expose its stream or a way to record custom commands into a
+  // command buffer, so the launch can't be ordered with the HAL device queue.
+  api.call(b, loc, "cudnn.graph.execute", TypeRange(), {executable, list});
+
+  auto result_type = call.getResult(0).getType().cast<RankedTensorType>();
+  Value imported = b.create<IREE::HAL::TensorImportOp>(
+      loc, result_type, result, TypeAttr::get(result_type),
+      get_dynamic_sizes(returned), /*waitFence=*/nullptr, /*name=*/nullptr);
+  call.getResult(0).replaceAllUsesWith(imported);
+  call.erase();
+}
+
+namespace {
+
+class ConvertCUDNNToRuntime
+    : public ::impl::ConvertCUDNNToRuntimeBase<ConvertCUDNNToRuntime> {
+ public:
+  void runOnOperation() override {
+    ModuleOp module = getOperation();
+    SymbolTable symbol_table(module);
+    RuntimeApi api(module, symbol_table);
+
+    // Lower all cuDNN graphs to initializers (static shapes) or functions
+    // (dynamic shapes) building cuDNN executables.
+    llvm::StringMap<SmallVector<int64_t>> alignments =
+        getArgumentAlignments(module);
+    llvm::DenseMap<StringRef, LoweredGraph> lowered;
+    for (auto graph : module.getOps<cudnn::GraphOp>()) {
+      auto arg_alignments = alignments.try_emplace(
+          graph.getName(),
+          SmallVector<int64_t>(graph.getNumArguments(), kBufferAlignment));
+      auto lowered_graph = lowerGraph(graph, arg_alignments.first->second,
+                                      api, symbol_table);
+      if (failed(lowered_graph)) return signalPassFailure();
+      lowered[graph.getName()] = std::move(*lowered_graph);
+    }
+
+    // Replace all cuDNN calls with executions of cached executables.
+    SmallVector<cudnn::CallOp> calls;
+    module.walk([&](cudnn::CallOp call) { calls.push_back(call); });
+    for (cudnn::CallOp call : calls)
+      lowerCall(call, lowered[call.getCallee()], api);
+
+    for (auto graph : llvm::make_early_inc_range(
+             module.getOps<cudnn::GraphOp>()))
+      symbol_table.erase(graph);
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> createConvertCUDNNToRuntimePass() {
+  return std::make_unique<ConvertCUDNNToRuntime>();
+}
+
+} // namespace openxla::compiler::nvgpu
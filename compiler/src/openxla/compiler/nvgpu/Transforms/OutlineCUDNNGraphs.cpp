@@ -0,0 +1,730 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/MathExtras.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/IR/OperationSupport.h"
+#include "mlir/IR/SymbolTable.h"
+#include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNDialect.h"
+#include "openxla/compiler/nvgpu/Dialect/CUDNN/IR/CUDNNOps.h"
+#include "openxla/compiler/nvgpu/Transforms/Passes.h"
+#include "stablehlo/dialect/StablehloOps.h"
+
+#define GEN_PASS_DEF_OUTLINECUDNNGRAPHS
+#include "openxla/compiler/nvgpu/Transforms/Passes.h.inc"
+
+using namespace mlir;
+
+namespace openxla::compiler::nvgpu {
+
+//===----------------------------------------------------------------------===//
+// Matching StableHLO operations convertible to cuDNN operations.
+//===----------------------------------------------------------------------===//
+
+// cuDNN tensors always have logical dimensions ordered as NCHW (batch, feature,
+// spatial dimensions), and convolution kernels as KCRS (output feature, input
+// feature, spatial dimensions). Dimension numbers of the StableHLO convolution
+// define positions of logical dimensions in physical tensors. Matmul operands
+// reuse the same struct: `input` is the [batch, m, k] lhs and `kernel` is the
+// [batch, k, n] rhs.
+struct ConvDims {
+  SmallVector<int64_t> input;
+  SmallVector<int64_t> kernel;
+  SmallVector<int64_t> output;
+};
+
+// Returns a cuDNN tensor type for a tensor with logical dimensions located at
+// `dims` positions. Uses one of the pre-defined layouts if possible, and falls
+// back on strides permutation map.
+static cudnn::TensorType getCudnnTensorType(RankedTensorType tensor_type,
+                                            ArrayRef<int64_t> dims) {
+  SmallVector<int64_t> shape(dims.size());
+  SmallVector<unsigned> permutation(dims.size());
+  for (auto [logical, physical] : llvm::enumerate(dims)) {
+    shape[logical] = tensor_type.getDimSize(physical);
+    permutation[physical] = logical;
+  }
+
+  Type element_type = tensor_type.getElementType();
+  ArrayRef<unsigned> perm(permutation);
+
+  if (perm == ArrayRef<unsigned>({0, 1, 2, 3}))
+    return cudnn::TensorType::get(shape, element_type, cudnn::Layout::NCHW);
+  if (perm == ArrayRef<unsigned>({0, 2, 3, 1}))
+    return cudnn::TensorType::get(shape, element_type, cudnn::Layout::NHWC);
+  if (llvm::is_sorted(perm))
+    return cudnn::TensorType::get(shape, element_type);
+
+  return cudnn::TensorType::get(
+      shape, element_type,
+      AffineMap::getPermutationMap(perm, tensor_type.getContext()));
+}
+
+// Returns attribute values, or `size` copies of the default `value` if the
+// attribute is not set.
+static SmallVector<int64_t> getValuesOr(
+    std::optional<DenseIntElementsAttr> attr, size_t size, int64_t value) {
+  if (!attr) return SmallVector<int64_t>(size, value);
+  return llvm::to_vector(attr->getValues<int64_t>());
+}
+
+// cuDNN tensors must have static shapes and rank from 3 to 8.
+static bool isCudnnTensor(Type type) {
+  auto tensor_type = type.dyn_cast<RankedTensorType>();
+  return tensor_type && tensor_type.hasStaticShape() &&
+         tensor_type.getRank() >= 3 && tensor_type.getRank() <= 8 &&
+         tensor_type.getElementType().isa<FloatType>();
+}
+
+// Matches a convolution that can be lowered to a cuDNN convolution.
+static FailureOr<ConvDims> matchConvolution(stablehlo::ConvolutionOp conv) {
+  if (!isCudnnTensor(conv.getLhs().getType()) ||
+      !isCudnnTensor(conv.getRhs().getType()) ||
+      !isCudnnTensor(conv.getType()))
+    return failure();
+
+  if (conv.getFeatureGroupCount() != 1 || conv.getBatchGroupCount() != 1)
+    return failure();
+
+  stablehlo::ConvDimensionNumbersAttr dnums = conv.getDimensionNumbers();
+  size_t num_spatial_dims = dnums.getInputSpatialDimensions().size();
+  if (num_spatial_dims != 2 && num_spatial_dims != 3) return failure();
+
+  // Transposed convolutions are not supported.
+  if (llvm::any_of(getValuesOr(conv.getLhsDilation(), num_spatial_dims, 1),
+                   [](int64_t dilation) { return dilation != 1; }))
+    return failure();
+
+  if (auto reversal = conv.getWindowReversal()) {
+    if (llvm::any_of(reversal->getValues<bool>(), [](bool b) { return b; }))
+      return failure();
+  }
+
+  if (llvm::any_of(getValuesOr(conv.getPadding(), 2 * num_spatial_dims, 0),
+                   [](int64_t padding) { return padding < 0; }))
+    return failure();
+
+  ConvDims dims;
+  dims.input = {dnums.getInputBatchDimension(),
+                dnums.getInputFeatureDimension()};
+  dims.kernel = {dnums.getKernelOutputFeatureDimension(),
+                 dnums.getKernelInputFeatureDimension()};
+  dims.output = {dnums.getOutputBatchDimension(),
+                 dnums.getOutputFeatureDimension()};
+  llvm::append_range(dims.input, dnums.getInputSpatialDimensions());
+  llvm::append_range(dims.kernel, dnums.getKernelSpatialDimensions());
+  llvm::append_range(dims.output, dnums.getOutputSpatialDimensions());
+  return dims;
+}
+
+// Matches a dot general that can be lowered to a cuDNN matmul: a batched matmul
+// of 3-D operands with a single batch dimension, or a matmul of 3-D lhs (two
+// non-contracting dimensions map to cuDNN batch and rows) and 2-D rhs (weights
+// shared by all batches, passed to cuDNN with a unit batch dimension).
+static FailureOr<ConvDims> matchMatmul(stablehlo::DotGeneralOp dot) {
+  if (!isCudnnTensor(dot.getLhs().getType()) || !isCudnnTensor(dot.getType()))
+    return failure();
+
+  auto lhs_type = dot.getLhs().getType().cast<RankedTensorType>();
+  auto rhs_type = dot.getRhs().getType().dyn_cast<RankedTensorType>();
+  if (lhs_type.getRank() != 3 || !rhs_type || !rhs_type.hasStaticShape())
+    return failure();
+
+  stablehlo::DotDimensionNumbersAttr dnums = dot.getDotDimensionNumbers();
+  ArrayRef<int64_t> lhs_batch = dnums.getLhsBatchingDimensions();
+  ArrayRef<int64_t> rhs_batch = dnums.getRhsBatchingDimensions();
+  ArrayRef<int64_t> lhs_contracting = dnums.getLhsContractingDimensions();
+  ArrayRef<int64_t> rhs_contracting = dnums.getRhsContractingDimensions();
+  if (lhs_contracting.size() != 1 || rhs_contracting.size() != 1)
+    return failure();
+
+  // Returns dimensions of a tensor of rank `rank` that are not in `dims`.
+  auto get_free_dims = [](int64_t rank, ArrayRef<int64_t> batch,
+                          ArrayRef<int64_t> contracting) {
+    SmallVector<int64_t> free;
+    for (int64_t d = 0; d < rank; ++d)
+      if (!llvm::is_contained(batch, d) && !llvm::is_contained(contracting, d))
+        free.push_back(d);
+    return free;
+  };
+  auto lhs_free = get_free_dims(3, lhs_batch, lhs_contracting);
+  auto rhs_free =
+      get_free_dims(rhs_type.getRank(), rhs_batch, rhs_contracting);
+
+  ConvDims dims;
+  dims.output = {0, 1, 2};
+
+  if (rhs_type.getRank() == 3 && lhs_batch.size() == 1 &&
+      rhs_batch.size() == 1) {
+    dims.input = {lhs_batch[0], lhs_free[0], lhs_contracting[0]};
+    dims.kernel = {rhs_batch[0], rhs_contracting[0], rhs_free[0]};
+    return dims;
+  }
+
+  // Dimensions of the 2-D rhs are shifted by the unit batch dimension.
+  if (rhs_type.getRank() == 2 && lhs_batch.empty()) {
+    dims.input = {lhs_free[0], lhs_free[1], lhs_contracting[0]};
+    dims.kernel = {0, rhs_contracting[0] + 1, rhs_free[0] + 1};
+    return dims;
+  }
+
+  return failure();
+}
+
+// Matches relu activation: `max(x, 0)` or `clamp(min, x, NaN)`. Returns the
+// activation input and the lower clip value.
+static std::optional<std::pair<Value, double>> matchRelu(Operation* op) {
+  if (auto max = dyn_cast<stablehlo::MaxOp>(op)) {
+    if (matchPattern(max.getRhs(), m_AnyZeroFloat()))
+      return std::make_pair(max.getLhs(), 0.0);
+    if (matchPattern(max.getLhs(), m_AnyZeroFloat()))
+      return std::make_pair(max.getRhs(), 0.0);
+    return std::nullopt;
+  }
+
+  if (auto clamp = dyn_cast<stablehlo::ClampOp>(op)) {
+    llvm::APFloat min = llvm::APFloat::IEEEdouble();
+    llvm::APFloat max = llvm::APFloat::IEEEdouble();
+    if (matchPattern(clamp.getMin(), m_ConstantFloat(&min)) &&
+        matchPattern(clamp.getMax(), m_ConstantFloat(&max)) && max.isNaN())
+      return std::make_pair(clamp.getOperand(), min.convertToDouble());
+    return std::nullopt;
+  }
+
+  return std::nullopt;
+}
+
+// Matches a splat floating point constant (possibly broadcasted) equal to the
+// `expected` value. Constants are compared with a relative tolerance, because
+// they are rounded to the tensor element type (e.g. fp16).
+static bool matchFloatConstant(Value value, double expected) {
+  if (auto bcast = value.getDefiningOp<stablehlo::BroadcastInDimOp>())
+    value = bcast.getOperand();
+
+  llvm::APFloat constant = llvm::APFloat::IEEEdouble();
+  if (!matchPattern(value, m_ConstantFloat(&constant))) return false;
+  return std::abs(constant.convertToDouble() - expected) <=
+         1e-2 * std::abs(expected);
+}
+
+// Matches `c * x` or `x + c` (in any operands order) where `c` is a constant
+// equal to `constant`. Returns `x` and appends matched operation to `ops`.
+template <typename OpTy>
+static Value matchWithConstant(Value value, double constant,
+                               SmallVector<Operation*>& ops) {
+  auto op = value.getDefiningOp<OpTy>();
+  if (!op) return nullptr;
+
+  for (auto [c, x] : {std::make_pair(op.getLhs(), op.getRhs()),
+                      std::make_pair(op.getRhs(), op.getLhs())}) {
+    if (!matchFloatConstant(c, constant)) continue;
+    ops.push_back(op);
+    return x;
+  }
+  return nullptr;
+}
+
+// Matches `x * (x * x)` (in any operands order).
+static bool matchCube(Value value, Value x, SmallVector<Operation*>& ops) {
+  auto mul = value.getDefiningOp<stablehlo::MulOp>();
+  if (!mul) return false;
+
+  for (auto [lhs, rhs] : {std::make_pair(mul.getLhs(), mul.getRhs()),
+                          std::make_pair(mul.getRhs(), mul.getLhs())}) {
+    auto square = rhs.getDefiningOp<stablehlo::MulOp>();
+    if (lhs != x || !square || square.getLhs() != x || square.getRhs() != x)
+      continue;
+    ops.append({mul, square});
+    return true;
+  }
+  return false;
+}
+
+// GELU activation matched in a StableHLO program.
+struct GeluMatch {
+  Value input;
+  // All operations computing the activation except the root multiply.
+  SmallVector<Operation*> ops;
+};
+
+// Matches GELU tanh approximation in the form computed by `jax.nn.gelu`:
+//
+//   x * (0.5 * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3))))
+//
+// All intermediate values must be used only by the activation itself.
+static std::optional<GeluMatch> matchGelu(Operation* op) {
+  auto root = dyn_cast<stablehlo::MulOp>(op);
+  if (!root) return std::nullopt;
+
+  auto match_cdf = [](Value cdf, Value x, SmallVector<Operation*>& ops) {
+    Value inner = matchWithConstant<stablehlo::MulOp>(cdf, 0.5, ops);
+    if (!inner) return false;
+
+    Value t = matchWithConstant<stablehlo::AddOp>(inner, 1.0, ops);
+    auto tanh = t ? t.getDefiningOp<stablehlo::TanhOp>() : stablehlo::TanhOp();
+    if (!tanh) return false;
+    ops.push_back(tanh);
+
+    Value u = matchWithConstant<stablehlo::MulOp>(
+        tanh.getOperand(), std::sqrt(2.0 / llvm::numbers::pi), ops);
+    auto add = u ? u.getDefiningOp<stablehlo::AddOp>() : stablehlo::AddOp();
+    if (!add) return false;
+    ops.push_back(add);
+
+    for (auto [lhs, rhs] : {std::make_pair(add.getLhs(), add.getRhs()),
+                            std::make_pair(add.getRhs(), add.getLhs())}) {
+      if (lhs != x) continue;
+      Value cube = matchWithConstant<stablehlo::MulOp>(rhs, 0.044715, ops);
+      return cube && matchCube(cube, x, ops);
+    }
+    return false;
+  };
+
+  for (auto [x, cdf] : {std::make_pair(root.getLhs(), root.getRhs()),
+                        std::make_pair(root.getRhs(), root.getLhs())}) {
+    SmallVector<Operation*> ops;
+    if (!match_cdf(cdf, x, ops)) continue;
+
+    bool has_external_users = llvm::any_of(ops, [&](Operation* op) {
+      return llvm::any_of(op->getUsers(), [&](Operation* user) {
+        return user != root && !llvm::is_contained(ops, user);
+      });
+    });
+    if (has_external_users) continue;
+
+    return GeluMatch{x, std::move(ops)};
+  }
+
+  return std::nullopt;
+}
+
+// Matches a bias add: `add(x, broadcast_in_dim(bias))` where `bias` is a 1-D
+// tensor. Returns the bias broadcast and `x`.
+static std::optional<std::pair<stablehlo::BroadcastInDimOp, Value>>
+matchBiasAdd(stablehlo::AddOp add) {
+  for (auto [bias, x] : {std::make_pair(add.getRhs(), add.getLhs()),
+                         std::make_pair(add.getLhs(), add.getRhs())}) {
+    auto bcast = bias.getDefiningOp<stablehlo::BroadcastInDimOp>();
+    if (!bcast) continue;
+
+    auto bias_type = bcast.getOperand().getType().dyn_cast<RankedTensorType>();
+    if (!bias_type || bias_type.getRank() != 1) continue;
+
+    return std::make_pair(bcast, x);
+  }
+  return std::nullopt;
+}
+
+//===----------------------------------------------------------------------===//
+// Clustering StableHLO operations into convolution and matmul epilogues.
+//===----------------------------------------------------------------------===//
+
+// A cluster of StableHLO operations that will be outlined into a cuDNN graph.
+// Cluster is anchored at a convolution or a matmul followed by a chain of
+// pointwise operations (epilogue). Each pointwise operation consumes the
+// previous cluster root, and other operands become graph arguments. All
+// operations except the last one (cluster root) have users only inside the
+// cluster, so the cluster is always convex and computes exactly one result, as
+// required by the `cudnn.graph`.
+struct Cluster {
+  ConvDims dims;
+  SmallVector<Operation*> ops; // in the block order
+
+  // Operations absorbed into the cluster as a part of composite pointwise
+  // operations (e.g. GELU), that have users only inside the composite.
+  SmallVector<Operation*> absorbed;
+
+  Operation* root() const { return ops.back(); }
+};
+
+// Returns the cluster that `op` can join if it uses the cluster root value,
+// and the root has no other users (except `op` composite operations).
+static Cluster* getJoinableCluster(
+    Operation* op, Value operand, ArrayRef<Operation*> composite,
+    const DenseMap<Operation*, Cluster*>& clusters) {
+  Operation* def = operand.getDefiningOp();
+  Cluster* cluster = def ? clusters.lookup(def) : nullptr;
+  if (!cluster || cluster->root() != def) return nullptr;
+
+  if (!llvm::all_of(def->getUsers(), [&](Operation* user) {
+        return user == op || llvm::is_contained(composite, user);
+      }))
+    return nullptr;
+
+  return cluster;
+}
+
+// Returns operands that can be produced by the cluster for pointwise `op` to
+// join it, or std::nullopt if the operation is not convertible to cuDNN. Only
+// relu, GELU and add (bias or residual) operations can extend the epilogue,
+// and `op` joins the cluster of the first operand that is a cluster root.
+static std::optional<SmallVector<Value>> getPointwiseOperands(Operation* op) {
+  if (!llvm::all_of(op->getResultTypes(), isCudnnTensor)) return std::nullopt;
+
+  if (auto relu = matchRelu(op)) return SmallVector<Value>{relu->first};
+  if (auto gelu = matchGelu(op)) return SmallVector<Value>{gelu->input};
+
+  if (auto add = dyn_cast<stablehlo::AddOp>(op)) {
+    if (auto bias = matchBiasAdd(add)) return SmallVector<Value>{bias->second};
+    return SmallVector<Value>{add.getLhs(), add.getRhs()};
+  }
+
+  return std::nullopt;
+}
+
+static SmallVector<std::unique_ptr<Cluster>> buildClusters(Block& block) {
+  SmallVector<std::unique_ptr<Cluster>> clusters;
+  DenseMap<Operation*, Cluster*> cluster_of;
+
+  for (Operation& op : block) {
+    // Every convolution starts a new cluster.
+    if (auto conv = dyn_cast<stablehlo::ConvolutionOp>(op)) {
+      auto dims = matchConvolution(conv);
+      if (failed(dims)) continue;
+
+      auto& cluster = clusters.emplace_back(std::make_unique<Cluster>());
+      cluster->dims = std::move(*dims);
+      cluster->ops.push_back(&op);
+      cluster_of[&op] = cluster.get();
+      continue;
+    }
+
+    // Every matmul starts a new cluster.
+    if (auto dot = dyn_cast<stablehlo::DotGeneralOp>(op)) {
+      auto dims = matchMatmul(dot);
+      if (failed(dims)) continue;
+
+      auto& cluster = clusters.emplace_back(std::make_unique<Cluster>());
+      cluster->dims = std::move(*dims);
+      cluster->ops.push_back(&op);
+      cluster_of[&op] = cluster.get();
+      continue;
+    }
+
+    // Pointwise operations join the cluster of one of the operands.
+    auto operands = getPointwiseOperands(&op);
+    if (!operands) continue;
+
+    // Composite pointwise operations join the cluster together with all the
+    // operations computing them.
+    SmallVector<Operation*> composite;
+    if (auto gelu = matchGelu(&op)) composite = std::move(gelu->ops);
+
+    Cluster* cluster = nullptr;
+    for (Value operand : *operands)
+      if ((cluster = getJoinableCluster(&op, operand, composite, cluster_of)))
+        break;
+
+    // Pointwise operations without a producer cluster are not worth offloading
+    // to cuDNN, because each cuDNN call is a separate synchronous launch.
+    if (!cluster) continue;
+    cluster->ops.push_back(&op);
+    llvm::append_range(cluster->absorbed, composite);
+    cluster_of[&op] = cluster;
+  }
+
+  return clusters;
+}
+
+//===----------------------------------------------------------------------===//
+// Outlining clusters into cuDNN graphs.
+//===----------------------------------------------------------------------===//
+
+// Arguments of the outlined cuDNN graph and corresponding call operands.
+struct GraphArguments {
+  // Returns a graph argument index for the value of the given cuDNN type.
+  unsigned getOrAdd(Value value, cudnn::TensorType type) {
+    auto [it, inserted] = index.try_emplace({value, type}, values.size());
+    if (inserted) {
+      values.push_back(value);
+      types.push_back(type);
+    }
+    return it->second;
+  }
+
+  DenseMap<std::pair<Value, Type>, unsigned> index;
+  SmallVector<Value> values;
+  SmallVector<Type> types;
+};
+
+// Returns a tensor type with unit dimensions except the dimension `dim`, that
+// is compatible with cuDNN broadcasting of a 1-D bias tensor.
+static RankedTensorType getBiasType(RankedTensorType bias_type,
+                                    RankedTensorType result_type,
+                                    int64_t dim) {
+  SmallVector<int64_t> shape(result_type.getRank(), 1);
+  shape[dim] = bias_type.getDimSize(0);
+  return RankedTensorType::get(shape, result_type.getElementType());
+}
+
+// Outlines cluster operations into a cuDNN graph that is not yet inserted into
+// the module, and returns it together with the call operands.
+static std::pair<cudnn::GraphOp, SmallVector<Value>> outlineCluster(
+    Cluster& cluster, OpBuilder& call_builder) {
+  MLIRContext* ctx = cluster.root()->getContext();
+  Location loc = cluster.root()->getLoc();
+
+  auto result_type =
+      cluster.root()->getResult(0).getType().cast<RankedTensorType>();
+  cudnn::TensorType y_type =
+      getCudnnTensorType(result_type, cluster.dims.output);
+
+  // cuDNN accumulates in fp32 for all floating point types except fp64.
+  Type element_type = result_type.getElementType();
+  Type compute_type =
+      element_type.isF64() ? element_type : Float32Type::get(ctx);
+
+  // Operations are first converted into a detached block, because graph
+  // arguments are not known until all operations are converted.
+  auto body = std::make_unique<Block>();
+  OpBuilder b = OpBuilder::atBlockEnd(body.get());
+
+  GraphArguments args;
+  DenseMap<Value, Value> mapping;
+  SmallVector<std::string> name;
+
+  // Returns a value in the graph body corresponding to the `value`.
+  auto get_value = [&](Value value, cudnn::TensorType type) -> Value {
+    if (Value mapped = mapping.lookup(value)) return mapped;
+    unsigned index = args.getOrAdd(value, type);
+    while (body->getNumArguments() <= index)
+      body->addArgument(args.types[body->getNumArguments()], loc);
+    return body->getArgument(index);
+  };
+
+  for (Operation* op : cluster.ops) {
+    Value result;
+
+    if (auto conv = dyn_cast<stablehlo::ConvolutionOp>(op)) {
+      size_t num_spatial_dims = cluster.dims.input.size() - 2;
+      Value x = get_value(
+          conv.getLhs(),
+          getCudnnTensorType(conv.getLhs().getType().cast<RankedTensorType>(),
+                             cluster.dims.input));
+      Value w = get_value(
+          conv.getRhs(),
+          getCudnnTensorType(conv.getRhs().getType().cast<RankedTensorType>(),
+                             cluster.dims.kernel));
+
+      auto padding = getValuesOr(conv.getPadding(), 2 * num_spatial_dims, 0);
+      SmallVector<int64_t> pre_padding, post_padding;
+      for (size_t i = 0; i < num_spatial_dims; ++i) {
+        pre_padding.push_back(padding[2 * i]);
+        post_padding.push_back(padding[2 * i + 1]);
+      }
+
+      // StableHLO convolution does not flip the kernel, which corresponds to
+      // the cuDNN cross correlation mode.
+      result = b.create<cudnn::CrossCorrelationOp>(
+          loc, y_type, x, w, compute_type, APFloat(1.0f), APFloat(0.0f),
+          num_spatial_dims,
+          getValuesOr(conv.getWindowStrides(), num_spatial_dims, 1),
+          pre_padding, post_padding,
+          getValuesOr(conv.getRhsDilation(), num_spatial_dims, 1));
+      name.push_back("conv");
+
+    } else if (auto dot = dyn_cast<stablehlo::DotGeneralOp>(op)) {
+      auto lhs_type = dot.getLhs().getType().cast<RankedTensorType>();
+      auto rhs_type = dot.getRhs().getType().cast<RankedTensorType>();
+
+      // 2-D weights are passed to the graph with a unit batch dimension.
+      Value rhs = dot.getRhs();
+      if (rhs_type.getRank() == 2) {
+        rhs_type = RankedTensorType::get(
+            {1, rhs_type.getDimSize(0), rhs_type.getDimSize(1)},
+            rhs_type.getElementType());
+        rhs = call_builder.create<stablehlo::ReshapeOp>(loc, rhs_type, rhs);
+      }
+
+      result = b.create<cudnn::MatMulOp>(
+          loc, y_type,
+          get_value(dot.getLhs(),
+                    getCudnnTensorType(lhs_type, cluster.dims.input)),
+          get_value(rhs, getCudnnTensorType(rhs_type, cluster.dims.kernel)),
+          compute_type);
+      name.push_back("matmul");
+
+    } else if (auto relu = matchRelu(op)) {
+      result = b.create<cudnn::PointWiseReluOp>(
+          loc, y_type, get_value(relu->first, y_type), compute_type,
+          APFloat(relu->second));
+      name.push_back("relu");
+
+    } else if (auto gelu = matchGelu(op)) {
+      result = b.create<cudnn::PointWiseGeluOp>(
+          loc, y_type, get_value(gelu->input, y_type), compute_type);
+      name.push_back("gelu");
+
+    } else if (auto add = dyn_cast<stablehlo::AddOp>(op)) {
+      if (auto bias = matchBiasAdd(add)) {
+        // Bias is passed to the graph as a tensor with unit dimensions in the
+        // same layout as the convolution output.
+        auto [bcast, x] = *bias;
+        int64_t dim = bcast.getBroadcastDimensions().getValues<int64_t>()[0];
+        RankedTensorType bias_type = getBiasType(
+            bcast.getOperand().getType().cast<RankedTensorType>(), result_type,
+            dim);
+        Value reshaped = call_builder.create<stablehlo::ReshapeOp>(
+            loc, bias_type, bcast.getOperand());
+        result = b.create<cudnn::PointWiseAddOp>(
+            loc, y_type, get_value(x, y_type),
+            get_value(reshaped,
+                      getCudnnTensorType(bias_type, cluster.dims.output)),
+            compute_type);
+        name.push_back("bias");
+      } else {
+        result = b.create<cudnn::PointWiseAddOp>(
+            loc, y_type, get_value(add.getLhs(), y_type),
+            get_value(add.getRhs(), y_type), compute_type);
+        name.push_back("add");
+      }
+    }
+
+    mapping[op->getResult(0)] = result;
+  }
+
+  b.create<cudnn::ReturnOp>(loc, mapping.lookup(cluster.root()->getResult(0)));
+
+  auto graph = OpBuilder(ctx).create<cudnn::GraphOp>(
+      loc, llvm::join(name, "_"), FunctionType::get(ctx, args.types, y_type));
+  graph.getBody().push_back(body.release());
+
+  return {graph, std::move(args.values)};
+}
+
+// Returns a hash of the cuDNN graph structure that does not depend on the
+// graph name and SSA value names.
+static llvm::hash_code hashGraph(cudnn::GraphOp graph) {
+  llvm::hash_code hash = hash_value(graph.getFunctionType());
+
+  DenseMap<Value, unsigned> ids;
+  Block& body = graph.getBody().front();
+  for (BlockArgument arg : body.getArguments()) ids[arg] = ids.size();
+
+  for (Operation& op : body) {
+    hash = llvm::hash_combine(hash, op.getName(), op.getAttrDictionary());
+    for (Value operand : op.getOperands())
+      hash = llvm::hash_combine(hash, ids.lookup(operand));
+    for (Value result : op.getResults()) {
+      hash = llvm::hash_combine(hash, result.getType());
+      ids[result] = ids.size();
+    }
+  }
+
+  return hash;
+}
+
+static bool isEquivalentGraph(cudnn::GraphOp lhs, cudnn::GraphOp rhs) {
+  return lhs.getFunctionType() == rhs.getFunctionType() &&
+         OperationEquivalence::isRegionEquivalentTo(
+             &lhs.getBody(), &rhs.getBody(),
+             OperationEquivalence::IgnoreLocations);
+}
+
+// Deduplicates structurally identical cuDNN graphs, so that the runtime builds
+// only one execution plan for each unique graph.
+class GraphDeduplicator {
+ public:
+  explicit GraphDeduplicator(ModuleOp module) : symbol_table_(module) {
+    for (auto graph : module.getOps<cudnn::GraphOp>())
+      graphs_[hashGraph(graph)].push_back(graph);
+  }
+
+  // Returns an existing graph equivalent to the `graph` (and erases it), or
+  // inserts `graph` into the module.
+  cudnn::GraphOp insert(cudnn::GraphOp graph) {
+    auto& candidates = graphs_[hashGraph(graph)];
+    for (cudnn::GraphOp candidate : candidates) {
+      if (isEquivalentGraph(candidate, graph)) {
+        graph->erase();
+        return candidate;
+      }
+    }
+
+    symbol_table_.insert(graph);
+    candidates.push_back(graph);
+    return graph;
+  }
+
+ private:
+  SymbolTable symbol_table_;
+  llvm::DenseMap<llvm::hash_code, SmallVector<cudnn::GraphOp>> graphs_;
+};
+
+static void outlineClusters(Block& block, GraphDeduplicator& graphs) {
+  for (auto& cluster : buildClusters(block)) {
+    Operation* root = cluster->root();
+
+    OpBuilder builder(root);
+    auto [graph, args] = outlineCluster(*cluster, builder);
+    graph = graphs.insert(graph);
+
+    auto call = builder.create<cudnn::CallOp>(
+        root->getLoc(), root->getResultTypes(), FlatSymbolRefAttr::get(graph),
+        args);
+    root->replaceAllUsesWith(call.getResults());
+
+    // Erase outlined operations, including operations absorbed by composite
+    // pointwise operations, and bias broadcasts that became dead. Absorbed
+    // operations are interleaved with the cluster operations in the block, so
+    // all of them are erased in the reverse block order (users before
+    // producers).
+    SmallVector<Operation*> outlined = cluster->ops;
+    llvm::append_range(outlined, cluster->absorbed);
+    llvm::sort(outlined, [](Operation* a, Operation* b) {
+      return b->isBeforeInBlock(a);
+    });
+
+    for (Operation* op : outlined) {
+      SmallVector<Operation*> defs;
+      for (Value operand : op->getOperands())
+        if (auto bcast = operand.getDefiningOp<stablehlo::BroadcastInDimOp>())
+          defs.push_back(bcast);
+      op->erase();
+      for (Operation* def : defs)
+        if (def->use_empty()) def->erase();
+    }
+  }
+}
+
+namespace {
+
+class OutlineCUDNNGraphs
+    : public ::impl::OutlineCUDNNGraphsBase<OutlineCUDNNGraphs> {
+ public:
+  void runOnOperation() override {
+    ModuleOp module = getOperation();
+    GraphDeduplicator graphs(module);
+
+    SmallVector<Block*> blocks;
+    for (auto func : module.getOps<func::FuncOp>())
+      for (Block& block : func.getBody()) blocks.push_back(&block);
+
+    for (Block* block : blocks) outlineClusters(*block, graphs);
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> createOutlineCUDNNGraphsPass() {
+  return std::make_unique<OutlineCUDNNGraphs>();
+}
+
+} // namespace openxla::compiler::nvgpu
@@ -13,6 +13,9 @@
 
 namespace openxla::compiler::nvgpu {
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createConvertMHLOToCUDNNPass();
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createOutlineCUDNNGraphsPass();
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createAssignCUDNNLayoutsPass();
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createConvertCUDNNToRuntimePass();
 } // namespace openxla::compiler::nvgpu
 
 #endif // OPENXLA_NVGPU_TRANSFORMS_PASSES_H_
@@ -0,0 +1,86 @@
+// RUN: iree-opt %s --iree-plugin=openxla_nvgpu --split-input-file \
+// RUN:   --pass-pipeline='builtin.module(openxla-nvgpu-assign-cudnn-layouts)' \
+// RUN:   | FileCheck %s
+
+// Tensor core convolution is converted to NHWC layout, and pointwise graph
+// consuming its result follows the producer layout.
+cudnn.graph @conv(%x: !cudnn.tensor<1x8x32x32xf16, NCHW>,
+                  %w: !cudnn.tensor<16x8x3x3xf16, NCHW>)
+                      -> !cudnn.tensor<1x16x32x32xf16, NCHW> {
+  %0 = cudnn.cross_correlation(%x, %w) type = f32 alpha = 1.0 beta = 0.0
+         spatial_dim_count = 2 spatial_stride = [1, 1] pre_padding = [1, 1]
+         post_padding = [1, 1] dilation = [1, 1]
+       : !cudnn.tensor<1x8x32x32xf16, NCHW>, !cudnn.tensor<16x8x3x3xf16, NCHW>
+         -> !cudnn.tensor<1x16x32x32xf16, NCHW>
+  cudnn.return %0: !cudnn.tensor<1x16x32x32xf16, NCHW>
+}
+
+cudnn.graph @relu(%x: !cudnn.tensor<1x16x32x32xf16, NCHW>)
+                      -> !cudnn.tensor<1x16x32x32xf16, NCHW> {
+  %0 = cudnn.pointwise_relu(%x) type = f32 lower_clip = 0.0
+       : !cudnn.tensor<1x16x32x32xf16, NCHW>
+         -> !cudnn.tensor<1x16x32x32xf16, NCHW>
+  cudnn.return %0: !cudnn.tensor<1x16x32x32xf16, NCHW>
+}
+
+func.func @main(%x: tensor<1x8x32x32xf16>,
+                %w: tensor<16x8x3x3xf16>) -> tensor<1x16x32x32xf16> {
+  %0 = cudnn.call @conv(%x, %w)
+       : (tensor<1x8x32x32xf16>, tensor<16x8x3x3xf16>)
+         -> tensor<1x16x32x32xf16>
+  %1 = cudnn.call @relu(%0)
+       : (tensor<1x16x32x32xf16>) -> tensor<1x16x32x32xf16>
+  return %1 : tensor<1x16x32x32xf16>
+}
+
+// CHECK: cudnn.graph @conv(
+// CHECK-SAME: !cudnn.tensor<1x8x32x32xf16, NHWC>
+// CHECK-SAME: !cudnn.tensor<16x8x3x3xf16, NHWC>
+// CHECK-SAME: -> !cudnn.tensor<1x16x32x32xf16, NHWC>
+// CHECK:   cudnn.cross_correlation
+// CHECK-SAME: -> !cudnn.tensor<1x16x32x32xf16, NHWC>
+
+// CHECK: cudnn.graph @relu(
+// CHECK-SAME: !cudnn.tensor<1x16x32x32xf16, NHWC>
+// CHECK-SAME: -> !cudnn.tensor<1x16x32x32xf16, NHWC>
+
+// CHECK: func.func @main(
+// CHECK:   %[[X:.*]]: tensor<1x8x32x32xf16>, %[[W:.*]]: tensor<16x8x3x3xf16>
+// CHECK: )
+// CHECK:   %[[XT:.*]] = stablehlo.transpose %[[X]], dims = [0, 2, 3, 1]
+// CHECK:   %[[WT:.*]] = stablehlo.transpose %[[W]], dims = [0, 2, 3, 1]
+// CHECK:   %[[CONV:.*]] = cudnn.call @conv(%[[XT]], %[[WT]])
+// CHECK-SAME: -> tensor<1x32x32x16xf16>
+// CHECK-NOT: stablehlo.transpose
+// CHECK:   %[[RELU:.*]] = cudnn.call @relu(%[[CONV]])
+// CHECK-SAME: (tensor<1x32x32x16xf16>) -> tensor<1x32x32x16xf16>
+// CHECK:   %[[RES:.*]] = stablehlo.transpose %[[RELU]], dims = [0, 3, 1, 2]
+// CHECK:   return %[[RES]]
+
+// -----
+
+// Convolutions that do not run on tensor cores keep the original layout.
+cudnn.graph @conv(%x: !cudnn.tensor<1x8x32x32xf32, NCHW>,
+                  %w: !cudnn.tensor<16x8x3x3xf32, NCHW>)
+                      -> !cudnn.tensor<1x16x32x32xf32, NCHW> {
+  %0 = cudnn.cross_correlation(%x, %w) type = f32 alpha = 1.0 beta = 0.0
+         spatial_dim_count = 2 spatial_stride = [1, 1] pre_padding = [1, 1]
+         post_padding = [1, 1] dilation = [1, 1]
+       : !cudnn.tensor<1x8x32x32xf32, NCHW>, !cudnn.tensor<16x8x3x3xf32, NCHW>
+         -> !cudnn.tensor<1x16x32x32xf32, NCHW>
+  cudnn.return %0: !cudnn.tensor<1x16x32x32xf32, NCHW>
+}
+
+func.func @main(%x: tensor<1x8x32x32xf32>,
+                %w: tensor<16x8x3x3xf32>) -> tensor<1x16x32x32xf32> {
+  %0 = cudnn.call @conv(%x, %w)
+       : (tensor<1x8x32x32xf32>, tensor<16x8x3x3xf32>)
+         -> tensor<1x16x32x32xf32>
+  return %0 : tensor<1x16x32x32xf32>
+}
+
+// CHECK: cudnn.graph @conv(
+// CHECK-SAME: !cudnn.tensor<1x8x32x32xf32, NCHW>
+// CHECK-NOT: stablehlo.transpose
+// CHECK: cudnn.call @conv
+// CHECK-NOT: stablehlo.transpose
@@ -0,0 +1,148 @@
+// RUN: iree-opt %s --iree-plugin=openxla_nvgpu --split-input-file \
+// RUN:   --pass-pipeline='builtin.module(openxla-nvgpu-outline-cudnn-graphs)' \
+// RUN:   | FileCheck %s
+
+func.func @conv_bias_relu_nchw(%x: tensor<1x8x32x32xf32>,
+                               %w: tensor<16x8x3x3xf32>,
+                               %b: tensor<16xf32>) -> tensor<1x16x32x32xf32> {
+  %zero = stablehlo.constant dense<0.0> : tensor<1x16x32x32xf32>
+  %conv = stablehlo.convolution(%x, %w)
+            dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1],
+            window = {stride = [1, 1], pad = [[1, 1], [1, 1]],
+                      rhs_dilate = [1, 1]}
+            {batch_group_count = 1 : i64, feature_group_count = 1 : i64}
+          : (tensor<1x8x32x32xf32>, tensor<16x8x3x3xf32>)
+            -> tensor<1x16x32x32xf32>
+  %bias = "stablehlo.broadcast_in_dim"(%b) {
+            broadcast_dimensions = dense<1> : tensor<1xi64>
+          } : (tensor<16xf32>) -> tensor<1x16x32x32xf32>
+  %add = stablehlo.add %conv, %bias : tensor<1x16x32x32xf32>
+  %relu = stablehlo.maximum %add, %zero : tensor<1x16x32x32xf32>
+  return %relu : tensor<1x16x32x32xf32>
+}
+
+// CHECK-LABEL: func.func @conv_bias_relu_nchw(
+// CHECK:   %[[X:.*]]: tensor<1x8x32x32xf32>, %[[W:.*]]: tensor<16x8x3x3xf32>,
+// CHECK:   %[[B:.*]]: tensor<16xf32>
+// CHECK: )
+// CHECK:   %[[BIAS:.*]] = stablehlo.reshape %[[B]]
+// CHECK-SAME: (tensor<16xf32>) -> tensor<1x16x1x1xf32>
+// CHECK:   %[[RES:.*]] = cudnn.call @conv_bias_relu(%[[X]], %[[W]], %[[BIAS]])
+// CHECK-NOT: stablehlo.convolution
+// CHECK:   return %[[RES]]
+
+// CHECK: cudnn.graph @conv_bias_relu(
+// CHECK-SAME: %[[ARG0:.*]]: !cudnn.tensor<1x8x32x32xf32, NCHW>,
+// CHECK-SAME: %[[ARG1:.*]]: !cudnn.tensor<16x8x3x3xf32, NCHW>,
+// CHECK-SAME: %[[ARG2:.*]]: !cudnn.tensor<1x16x1x1xf32, NCHW>
+// CHECK-SAME: ) -> !cudnn.tensor<1x16x32x32xf32, NCHW>
+// CHECK:   %[[CONV:.*]] = cudnn.cross_correlation(%[[ARG0]], %[[ARG1]])
+// CHECK-SAME: type = f32
+// CHECK-SAME: spatial_stride = [1, 1]
+// CHECK-SAME: pre_padding = [1, 1] post_padding = [1, 1] dilation = [1, 1]
+// CHECK:   %[[ADD:.*]] = cudnn.pointwise_add(%[[CONV]], %[[ARG2]]) type = f32
+// CHECK:   %[[RELU:.*]] = cudnn.pointwise_relu(%[[ADD]]) type = f32
+// CHECK-SAME: lower_clip = 0.000000e+00
+// CHECK:   cudnn.return %[[RELU]]
+
+// -----
+
+func.func @conv_bias_relu_nhwc(%x: tensor<1x32x32x8xf32>,
+                               %w: tensor<16x3x3x8xf32>,
+                               %b: tensor<16xf32>) -> tensor<1x16x16x16xf32> {
+  %min = stablehlo.constant dense<0.0> : tensor<1x16x16x16xf32>
+  %max = stablehlo.constant dense<0x7FC00000> : tensor<1x16x16x16xf32>
+  %conv = stablehlo.convolution(%x, %w)
+            dim_numbers = [b, 0, 1, f]x[o, 0, 1, i]->[b, 0, 1, f],
+            window = {stride = [2, 2], pad = [[0, 1], [0, 1]],
+                      rhs_dilate = [1, 1]}
+            {batch_group_count = 1 : i64, feature_group_count = 1 : i64}
+          : (tensor<1x32x32x8xf32>, tensor<16x3x3x8xf32>)
+            -> tensor<1x16x16x16xf32>
+  %bias = "stablehlo.broadcast_in_dim"(%b) {
+            broadcast_dimensions = dense<3> : tensor<1xi64>
+          } : (tensor<16xf32>) -> tensor<1x16x16x16xf32>
+  %add = stablehlo.add %bias, %conv : tensor<1x16x16x16xf32>
+  %relu = stablehlo.clamp %min, %add, %max : tensor<1x16x16x16xf32>
+  return %relu : tensor<1x16x16x16xf32>
+}
+
+// CHECK-LABEL: func.func @conv_bias_relu_nhwc(
+// CHECK:   %[[BIAS:.*]] = stablehlo.reshape
+// CHECK-SAME: (tensor<16xf32>) -> tensor<1x1x1x16xf32>
+// CHECK:   cudnn.call @conv_bias_relu(%{{.*}}, %{{.*}}, %[[BIAS]])
+// CHECK-SAME: : (tensor<1x32x32x8xf32>, tensor<16x3x3x8xf32>,
+// CHECK-SAME:    tensor<1x1x1x16xf32>) -> tensor<1x16x16x16xf32>
+
+// CHECK: cudnn.graph @conv_bias_relu(
+// CHECK-SAME: !cudnn.tensor<1x8x32x32xf32, NHWC>,
+// CHECK-SAME: !cudnn.tensor<16x8x3x3xf32, NHWC>,
+// CHECK-SAME: !cudnn.tensor<1x16x1x1xf32, NHWC>
+// CHECK-SAME: ) -> !cudnn.tensor<1x16x16x16xf32, NHWC>
+// CHECK:   cudnn.cross_correlation
+// CHECK-SAME: spatial_stride = [2, 2]
+// CHECK-SAME: pre_padding = [0, 0] post_padding = [1, 1] dilation = [1, 1]
+// CHECK:   cudnn.pointwise_add
+// CHECK:   cudnn.pointwise_relu
+
+// -----
+
+func.func @conv_relu_hwio(%x: tensor<1x32x32x8xf32>,
+                          %w: tensor<3x3x8x16xf32>) -> tensor<1x32x32x16xf32> {
+  %zero = stablehlo.constant dense<0.0> : tensor<1x32x32x16xf32>
+  %conv = stablehlo.convolution(%x, %w)
+            dim_numbers = [b, 0, 1, f]x[0, 1, i, o]->[b, 0, 1, f],
+            window = {stride = [1, 1], pad = [[2, 2], [2, 2]],
+                      rhs_dilate = [2, 2]}
+            {batch_group_count = 1 : i64, feature_group_count = 1 : i64}
+          : (tensor<1x32x32x8xf32>, tensor<3x3x8x16xf32>)
+            -> tensor<1x32x32x16xf32>
+  %relu = stablehlo.maximum %zero, %conv : tensor<1x32x32x16xf32>
+  return %relu : tensor<1x32x32x16xf32>
+}
+
+// CHECK-LABEL: func.func @conv_relu_hwio(
+// CHECK:   cudnn.call @conv_relu(%{{.*}}, %{{.*}})
+// CHECK-SAME: : (tensor<1x32x32x8xf32>, tensor<3x3x8x16xf32>)
+// CHECK-SAME:   -> tensor<1x32x32x16xf32>
+
+// CHECK: cudnn.graph @conv_relu(
+// CHECK-SAME: !cudnn.tensor<1x8x32x32xf32, NHWC>,
+// CHECK-SAME: !cudnn.tensor<16x8x3x3xf32,
+// CHECK-SAME:   affine_map<(d0, d1, d2, d3) -> (d2, d3, d1, d0)>>
+// CHECK-SAME: ) -> !cudnn.tensor<1x16x32x32xf32, NHWC>
+// CHECK:   cudnn.cross_correlation
+// CHECK-SAME: pre_padding = [2, 2] post_padding = [2, 2] dilation = [2, 2]
+// CHECK-NOT: cudnn.pointwise_add
+// CHECK:   cudnn.pointwise_relu
+
+// -----
+
+// Convolution result is used outside of the fused chain, and relu is not
+// offloaded to cuDNN on its own.
+func.func @conv_multiple_uses(%x: tensor<1x8x32x32xf32>,
+                              %w: tensor<16x8x1x1xf32>)
+    -> (tensor<1x16x32x32xf32>, tensor<1x16x32x32xf32>) {
+  %zero = stablehlo.constant dense<0.0> : tensor<1x16x32x32xf32>
+  %conv = stablehlo.convolution(%x, %w)
+            dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1],
+            window = {stride = [1, 1], pad = [[0, 0], [0, 0]],
+                      rhs_dilate = [1, 1]}
+            {batch_group_count = 1 : i64, feature_group_count = 1 : i64}
+          : (tensor<1x8x32x32xf32>, tensor<16x8x1x1xf32>)
+            -> tensor<1x16x32x32xf32>
+  %relu = stablehlo.maximum %conv, %zero : tensor<1x16x32x32xf32>
+  return %conv, %relu : tensor<1x16x32x32xf32>, tensor<1x16x32x32xf32>
+}
+
+// CHECK-LABEL: func.func @conv_multiple_uses(
+// CHECK:   %[[CONV:.*]] = cudnn.call @conv(
+// CHECK:   %[[RELU:.*]] = stablehlo.maximum %[[CONV]],
+// CHECK:   return %[[CONV]], %[[RELU]]
+
+// CHECK: cudnn.graph @conv(
+// CHECK:   cudnn.cross_correlation
+// CHECK-NOT: cudnn.pointwise_relu
+// CHECK:   cudnn.return
+
+// CHECK-NOT: cudnn.graph @relu(
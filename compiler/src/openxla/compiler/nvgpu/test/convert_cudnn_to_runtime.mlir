@@ -0,0 +1,258 @@
+// RUN: iree-opt %s --iree-plugin=openxla_nvgpu --split-input-file \
+// RUN:   --pass-pipeline='builtin.module(openxla-nvgpu-convert-cudnn-to-runtime)' \
+// RUN:   | FileCheck %s
+
+cudnn.graph @add_relu(%x: !cudnn.tensor<1x8x4x4xf32, NHWC>,
+                      %b: !cudnn.tensor<1x8x1x1xf32, NHWC>)
+                          -> !cudnn.tensor<1x8x4x4xf32, NHWC> {
+  %0 = cudnn.pointwise_add(%x, %b) type = f32
+       : !cudnn.tensor<1x8x4x4xf32, NHWC>, !cudnn.tensor<1x8x1x1xf32, NHWC>
+         -> !cudnn.tensor<1x8x4x4xf32, NHWC>
+  %1 = cudnn.pointwise_relu(%0) type = f32 lower_clip = 0.0
+       : !cudnn.tensor<1x8x4x4xf32, NHWC> -> !cudnn.tensor<1x8x4x4xf32, NHWC>
+  cudnn.return %1: !cudnn.tensor<1x8x4x4xf32, NHWC>
+}
+
+func.func @main(%x: tensor<1x4x4x8xf32>,
+                %b: tensor<1x1x1x8xf32>) -> tensor<1x4x4x8xf32> {
+  %0 = cudnn.call @add_relu(%x, %b)
+       : (tensor<1x4x4x8xf32>, tensor<1x1x1x8xf32>) -> tensor<1x4x4x8xf32>
+  %1 = cudnn.call @add_relu(%0, %b)
+       : (tensor<1x4x4x8xf32>, tensor<1x1x1x8xf32>) -> tensor<1x4x4x8xf32>
+  return %1 : tensor<1x4x4x8xf32>
+}
+
+// CHECK-NOT: cudnn.graph
+
+// CHECK: func.func private @cudnn.graph.execute(
+// CHECK-SAME: !cudnn.executable, !util.list<!hal.buffer_view>)
+// CHECK: func.func private @cudnn.graph.compile(
+// CHECK-SAME: !cudnn.operation_graph, i64) -> !cudnn.executable
+// CHECK: func.func private @cudnn.graph.create(
+// CHECK-SAME: !cudnn.tensor) -> !cudnn.operation_graph
+// CHECK: func.func private @cudnn.pointwise_relu(
+// CHECK-SAME: !cudnn.tensor, f32, f32, i64, i64) -> !cudnn.tensor
+// CHECK: func.func private @cudnn.pointwise_add(
+// CHECK-SAME: !cudnn.tensor, !cudnn.tensor, i64, i64) -> !cudnn.tensor
+// CHECK: func.func private @cudnn.tensor.arg.strided(
+// CHECK-SAME: i64, !util.list<i64>, !util.list<i64>, i64, i64)
+// CHECK-SAME: -> !cudnn.tensor
+
+// CHECK: util.global private @add_relu.executable : !cudnn.executable
+
+// CHECK: util.initializer {
+// CHECK:       %[[X:.*]] = func.call @cudnn.tensor.arg.strided(
+// CHECK:       %[[B:.*]] = func.call @cudnn.tensor.arg.strided(
+// CHECK:       %[[ADD:.*]] = func.call @cudnn.pointwise_add(%[[X]], %[[B]],
+// CHECK:       %[[RELU:.*]] = func.call @cudnn.pointwise_relu(%[[ADD]],
+// CHECK:       %[[GRAPH:.*]] = func.call @cudnn.graph.create(%[[RELU]])
+// CHECK:       %[[EXE:.*]] = func.call @cudnn.graph.compile(%[[GRAPH]]
+// CHECK:       util.global.store %[[EXE]], @add_relu.executable
+// CHECK: }
+
+// CHECK: func.func @main(
+// CHECK:   %[[X:.*]]: tensor<1x4x4x8xf32>, %[[B:.*]]: tensor<1x1x1x8xf32>
+// CHECK: )
+// CHECK:   %[[RES:.*]] = tensor.empty() : tensor<1x4x4x8xf32>
+// CHECK-NOT: tensor.empty
+// CHECK:   %[[X_VIEW:.*]] = hal.tensor.export %[[X]]
+// CHECK:   %[[B_VIEW:.*]] = hal.tensor.export %[[B]]
+// CHECK:   %[[RES_VIEW:.*]] = hal.tensor.export %[[RES]]
+// CHECK:   %[[BUFFERS:.*]] = util.list.create
+// CHECK:   util.list.set %[[BUFFERS]][%{{.*}}], %[[X_VIEW]]
+// CHECK:   util.list.set %[[BUFFERS]][%{{.*}}], %[[B_VIEW]]
+// CHECK:   util.list.set %[[BUFFERS]][%{{.*}}], %[[RES_VIEW]]
+// CHECK-NOT: util.list.set
+// CHECK:   %[[EXE:.*]] = util.global.load @add_relu.executable
+// CHECK:   call @cudnn.graph.execute(%[[EXE]], %[[BUFFERS]])
+// CHECK-NOT: hal.fence
+// CHECK:   %[[RESULT:.*]] = hal.tensor.import %[[RES_VIEW]]
+// CHECK:   util.global.load @add_relu.executable
+// CHECK:   call @cudnn.graph.execute
+// CHECK:   hal.tensor.import
+// CHECK-NOT: cudnn.call
+
+// -----
+
+cudnn.graph @relu(%x: !cudnn.tensor<?x8x4x4xf32, NHWC>)
+                      -> !cudnn.tensor<?x8x4x4xf32, NHWC> {
+  %0 = cudnn.pointwise_relu(%x) type = f32 lower_clip = 0.0
+       : !cudnn.tensor<?x8x4x4xf32, NHWC> -> !cudnn.tensor<?x8x4x4xf32, NHWC>
+  cudnn.return %0: !cudnn.tensor<?x8x4x4xf32, NHWC>
+}
+
+func.func @main(%x: tensor<?x4x4x8xf32>) -> tensor<?x4x4x8xf32> {
+  %0 = cudnn.call @relu(%x) : (tensor<?x4x4x8xf32>) -> tensor<?x4x4x8xf32>
+  return %0 : tensor<?x4x4x8xf32>
+}
+
+// CHECK-NOT: cudnn.graph
+// CHECK-NOT: util.initializer
+
+// CHECK: func.func private @relu.build(
+// CHECK:   %[[SHAPE:.*]]: !util.list<i64>
+// CHECK: ) -> !cudnn.executable
+// CHECK:   %[[N:.*]] = util.list.get %[[SHAPE]][%{{.*}}] : !util.list<i64>
+// CHECK:   %[[X:.*]] = func.call @cudnn.tensor.arg.strided(
+// CHECK:   %[[RELU:.*]] = func.call @cudnn.pointwise_relu(%[[X]],
+// CHECK:   %[[GRAPH:.*]] = func.call @cudnn.graph.create(%[[RELU]])
+// CHECK:   %[[EXE:.*]] = func.call @cudnn.graph.compile(%[[GRAPH]]
+// CHECK:   return %[[EXE]] : !cudnn.executable
+
+// CHECK: func.func @main(%[[X:.*]]: tensor<?x4x4x8xf32>)
+// CHECK:   %[[C0:.*]] = arith.constant 0 : index
+// CHECK:   %[[D0:.*]] = tensor.dim %[[X]], %[[C0]]
+// CHECK:   %[[RES:.*]] = tensor.empty(%[[D0]]) : tensor<?x4x4x8xf32>
+// CHECK:   %[[X_VIEW:.*]] = hal.tensor.export %[[X]]
+// CHECK:   %[[RES_VIEW:.*]] = hal.tensor.export %[[RES]]
+// CHECK:   %[[N:.*]] = arith.index_cast %[[D0]] : index to i64
+// CHECK:   %[[SHAPE:.*]] = util.list.create
+// CHECK:   util.list.set %[[SHAPE]][%{{.*}}], %[[N]] : !util.list<i64>
+// CHECK:   %[[FOUND:.*]]:2 = call @cudnn.executable.lookup(%{{.*}}, %[[SHAPE]])
+// CHECK:   %[[CACHED:.*]] = arith.cmpi ne, %[[FOUND]]#0
+// CHECK:   %[[EXE:.*]] = scf.if %[[CACHED]] -> (!cudnn.executable) {
+// CHECK:     scf.yield %[[FOUND]]#1 : !cudnn.executable
+// CHECK:   } else {
+// CHECK:     %[[BUILT:.*]] = func.call @relu.build(%[[SHAPE]])
+// CHECK:     call @cudnn.executable.memoize(%{{.*}}, %[[SHAPE]], %[[BUILT]])
+// CHECK:     scf.yield %[[BUILT]] : !cudnn.executable
+// CHECK:   }
+// CHECK:   call @cudnn.graph.execute(%[[EXE]], %{{.*}})
+// CHECK:   hal.tensor.import %[[RES_VIEW]]
+// CHECK-SAME: : !hal.buffer_view -> tensor<?x4x4x8xf32>{%[[D0]]}
+// CHECK-NOT: cudnn.call
+
+// -----
+
+// Slice at an 8-byte offset is passed to cuDNN with an 8-byte alignment, and
+// the result allocated for the call has the HAL buffer alignment. Alignments
+// are checked through the call operands, because they are emitted together
+// with the static dimensions constants.
+cudnn.graph @relu(%x: !cudnn.tensor<1x6x4x4xf32, NHWC>)
+                      -> !cudnn.tensor<1x6x4x4xf32, NHWC> {
+  %0 = cudnn.pointwise_relu(%x) type = f32 lower_clip = 0.0
+       : !cudnn.tensor<1x6x4x4xf32, NHWC> -> !cudnn.tensor<1x6x4x4xf32, NHWC>
+  cudnn.return %0: !cudnn.tensor<1x6x4x4xf32, NHWC>
+}
+
+func.func @main() -> tensor<1x4x4x6xf32> {
+  %x = arith.constant dense<1.0> : tensor<1x4x4x8xf32>
+  %0 = tensor.extract_slice %x[0, 0, 0, 2] [1, 4, 4, 6] [1, 1, 1, 1]
+       : tensor<1x4x4x8xf32> to tensor<1x4x4x6xf32>
+  %1 = cudnn.call @relu(%0) : (tensor<1x4x4x6xf32>) -> tensor<1x4x4x6xf32>
+  return %1 : tensor<1x4x4x6xf32>
+}
+
+// CHECK: util.initializer {
+// CHECK-DAG: %[[RES_ALIGN:.*]] = arith.constant 16 : i64
+// CHECK-DAG: %[[ARG_ALIGN:.*]] = arith.constant 8 : i64
+// CHECK:     %[[X:.*]] = func.call @cudnn.tensor.arg.strided(
+// CHECK-SAME: %[[ARG_ALIGN]]) :
+// CHECK:     func.call @cudnn.pointwise_relu(%[[X]],
+// CHECK-SAME: %[[RES_ALIGN]]) :
+
+// -----
+
+// Function arguments can be imported from buffer views at any offset, and
+// graph arguments bound to them are only element aligned.
+cudnn.graph @relu(%x: !cudnn.tensor<1x8x4x4xbf16, NHWC>)
+                      -> !cudnn.tensor<1x8x4x4xbf16, NHWC> {
+  %0 = cudnn.pointwise_relu(%x) type = f32 lower_clip = 0.0
+       : !cudnn.tensor<1x8x4x4xbf16, NHWC> -> !cudnn.tensor<1x8x4x4xbf16, NHWC>
+  cudnn.return %0: !cudnn.tensor<1x8x4x4xbf16, NHWC>
+}
+
+func.func @main(%x: tensor<1x4x4x8xbf16>) -> tensor<1x4x4x8xbf16> {
+  %0 = tensor.collapse_shape %x [[0, 1], [2], [3]]
+       : tensor<1x4x4x8xbf16> into tensor<4x4x8xbf16>
+  %1 = tensor.expand_shape %0 [[0, 1], [2], [3]]
+       : tensor<4x4x8xbf16> into tensor<1x4x4x8xbf16>
+  %2 = cudnn.call @relu(%1) : (tensor<1x4x4x8xbf16>) -> tensor<1x4x4x8xbf16>
+  return %2 : tensor<1x4x4x8xbf16>
+}
+
+// CHECK: util.initializer {
+// CHECK-DAG: %[[RES_ALIGN:.*]] = arith.constant 16 : i64
+// CHECK-DAG: %[[ARG_ALIGN:.*]] = arith.constant 2 : i64
+// CHECK:     %[[X:.*]] = func.call @cudnn.tensor.arg.strided(
+// CHECK-SAME: %[[ARG_ALIGN]]) :
+// CHECK:     func.call @cudnn.pointwise_relu(%[[X]],
+// CHECK-SAME: %[[RES_ALIGN]]) :
+
+// -----
+
+cudnn.graph @matmul_gelu(%a: !cudnn.tensor<4x128x256xf16>,
+                         %b: !cudnn.tensor<1x256x512xf16>)
+                             -> !cudnn.tensor<4x128x512xf16> {
+  %0 = cudnn.matmul(%a, %b) type = f32
+       : !cudnn.tensor<4x128x256xf16>, !cudnn.tensor<1x256x512xf16>
+         -> !cudnn.tensor<4x128x512xf16>
+  %1 = cudnn.pointwise_gelu(%0) type = f32
+       : !cudnn.tensor<4x128x512xf16> -> !cudnn.tensor<4x128x512xf16>
+  cudnn.return %1: !cudnn.tensor<4x128x512xf16>
+}
+
+func.func @main(%a: tensor<4x128x256xf16>,
+                %b: tensor<1x256x512xf16>) -> tensor<4x128x512xf16> {
+  %0 = cudnn.call @matmul_gelu(%a, %b)
+       : (tensor<4x128x256xf16>, tensor<1x256x512xf16>)
+         -> tensor<4x128x512xf16>
+  return %0 : tensor<4x128x512xf16>
+}
+
+// CHECK: func.func private @cudnn.pointwise_gelu(
+// CHECK-SAME: !cudnn.tensor, i64, i64) -> !cudnn.tensor
+// CHECK: func.func private @cudnn.matmul(
+// CHECK-SAME: !cudnn.tensor, !cudnn.tensor, i64, i64) -> !cudnn.tensor
+
+// CHECK: util.initializer {
+// CHECK:   %[[A:.*]] = func.call @cudnn.tensor.arg.strided(
+// CHECK:   %[[B:.*]] = func.call @cudnn.tensor.arg.strided(
+// CHECK:   %[[MATMUL:.*]] = func.call @cudnn.matmul(%[[A]], %[[B]],
+// CHECK:   %[[GELU:.*]] = func.call @cudnn.pointwise_gelu(%[[MATMUL]],
+// CHECK:   func.call @cudnn.graph.create(%[[GELU]])
+
+// CHECK: func.func @main
+// CHECK:   %[[RES:.*]] = tensor.empty() : tensor<4x128x512xf16>
+// CHECK-NOT: tensor.empty
+// CHECK:   call @cudnn.graph.execute
+
+// -----
+
+cudnn.graph @conv(%x: !cudnn.tensor<?x8x32x32xf16, NHWC>,
+                  %w: !cudnn.tensor<16x8x3x3xf16, NHWC>)
+                      -> !cudnn.tensor<?x16x16x16xf16, NHWC> {
+  %0 = cudnn.cross_correlation(%x, %w) type = f32 alpha = 1.0 beta = 0.0
+         spatial_dim_count = 2 spatial_stride = [2, 2] pre_padding = [1, 1]
+         post_padding = [1, 1] dilation = [1, 1]
+       : !cudnn.tensor<?x8x32x32xf16, NHWC>, !cudnn.tensor<16x8x3x3xf16, NHWC>
+         -> !cudnn.tensor<?x16x16x16xf16, NHWC>
+  cudnn.return %0: !cudnn.tensor<?x16x16x16xf16, NHWC>
+}
+
+func.func @main(%x: tensor<?x32x32x8xf16>,
+                %w: tensor<16x3x3x8xf16>) -> tensor<?x16x16x16xf16> {
+  %0 = cudnn.call @conv(%x, %w)
+       : (tensor<?x32x32x8xf16>, tensor<16x3x3x8xf16>)
+         -> tensor<?x16x16x16xf16>
+  return %0 : tensor<?x16x16x16xf16>
+}
+
+// CHECK: func.func private @cudnn.convolution(
+// CHECK-SAME: !cudnn.tensor, !cudnn.tensor, i64, f32, f32,
+// CHECK-SAME: !util.list<i64>, !util.list<i64>, !util.list<i64>,
+// CHECK-SAME: !util.list<i64>, i64, i64, i32) -> !cudnn.tensor
+
+// CHECK: func.func private @conv.build(
+// CHECK:   %[[X:.*]] = func.call @cudnn.tensor.arg.strided(
+// CHECK:   %[[W:.*]] = func.call @cudnn.tensor.arg.strided(
+// CHECK:   %[[MODE:.*]] = arith.constant 1 : i64
+// CHECK:   %[[ALPHA:.*]] = arith.constant 1.000000e+00 : f32
+// CHECK:   %[[BETA:.*]] = arith.constant 0.000000e+00 : f32
+// CHECK:   %[[CONV:.*]] = func.call @cudnn.convolution(%[[X]], %[[W]],
+// CHECK-SAME: %[[MODE]], %[[ALPHA]], %[[BETA]]
+// CHECK:   func.call @cudnn.graph.create(%[[CONV]])
+
+// CHECK: func.func @main(%[[X:.*]]: tensor<?x32x32x8xf16>
+// CHECK:   %[[N:.*]] = tensor.dim %[[X]], %{{.*}}
+// CHECK:   tensor.empty(%[[N]]) : tensor<?x16x16x16xf16>
@@ -0,0 +1,156 @@
+// RUN: iree-opt %s --iree-plugin=openxla_nvgpu --split-input-file \
+// RUN:   --pass-pipeline='builtin.module(openxla-nvgpu-outline-cudnn-graphs)' \
+// RUN:   | FileCheck %s
+
+// Residual connection is fused into the convolution epilogue.
+func.func @conv_residual_relu(%x: tensor<1x8x32x32xf32>,
+                              %w: tensor<8x8x1x1xf32>)
+    -> tensor<1x8x32x32xf32> {
+  %zero = stablehlo.constant dense<0.0> : tensor<1x8x32x32xf32>
+  %conv = stablehlo.convolution(%x, %w)
+            dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1],
+            window = {stride = [1, 1], pad = [[0, 0], [0, 0]],
+                      rhs_dilate = [1, 1]}
+            {batch_group_count = 1 : i64, feature_group_count = 1 : i64}
+          : (tensor<1x8x32x32xf32>, tensor<8x8x1x1xf32>)
+            -> tensor<1x8x32x32xf32>
+  %add = stablehlo.add %x, %conv : tensor<1x8x32x32xf32>
+  %relu = stablehlo.maximum %add, %zero : tensor<1x8x32x32xf32>
+  return %relu : tensor<1x8x32x32xf32>
+}
+
+// CHECK-LABEL: func.func @conv_residual_relu(
+// CHECK:   %[[X:.*]]: tensor<1x8x32x32xf32>, %[[W:.*]]: tensor<8x8x1x1xf32>
+// CHECK: )
+// CHECK:   %[[RES:.*]] = cudnn.call @conv_add_relu(%[[X]], %[[W]])
+// CHECK-NOT: stablehlo.add
+// CHECK:   return %[[RES]]
+
+// CHECK: cudnn.graph @conv_add_relu(
+// CHECK-SAME: %[[ARG0:.*]]: !cudnn.tensor<1x8x32x32xf32, NCHW>,
+// CHECK-SAME: %[[ARG1:.*]]: !cudnn.tensor<8x8x1x1xf32, NCHW>
+// CHECK-SAME: ) -> !cudnn.tensor<1x8x32x32xf32, NCHW>
+// CHECK:   %[[CONV:.*]] = cudnn.cross_correlation(%[[ARG0]], %[[ARG1]])
+// CHECK:   %[[ADD:.*]] = cudnn.pointwise_add(%[[ARG0]], %[[CONV]])
+// CHECK:   %[[RELU:.*]] = cudnn.pointwise_relu(%[[ADD]])
+// CHECK:   cudnn.return %[[RELU]]
+
+// -----
+
+// Structurally identical regions share the same cuDNN graph.
+func.func @dedup(%x: tensor<1x8x32x32xf32>, %w0: tensor<8x8x3x3xf32>,
+                 %w1: tensor<8x8x3x3xf32>) -> tensor<1x8x32x32xf32> {
+  %zero = stablehlo.constant dense<0.0> : tensor<1x8x32x32xf32>
+  %conv0 = stablehlo.convolution(%x, %w0)
+            dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1],
+            window = {stride = [1, 1], pad = [[1, 1], [1, 1]],
+                      rhs_dilate = [1, 1]}
+            {batch_group_count = 1 : i64, feature_group_count = 1 : i64}
+          : (tensor<1x8x32x32xf32>, tensor<8x8x3x3xf32>)
+            -> tensor<1x8x32x32xf32>
+  %relu0 = stablehlo.maximum %conv0, %zero : tensor<1x8x32x32xf32>
+  %conv1 = stablehlo.convolution(%relu0, %w1)
+            dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1],
+            window = {stride = [1, 1], pad = [[1, 1], [1, 1]],
+                      rhs_dilate = [1, 1]}
+            {batch_group_count = 1 : i64, feature_group_count = 1 : i64}
+          : (tensor<1x8x32x32xf32>, tensor<8x8x3x3xf32>)
+            -> tensor<1x8x32x32xf32>
+  %relu1 = stablehlo.maximum %conv1, %zero : tensor<1x8x32x32xf32>
+  return %relu1 : tensor<1x8x32x32xf32>
+}
+
+// CHECK-LABEL: func.func @dedup(
+// CHECK:   %[[X:.*]]: tensor<1x8x32x32xf32>, %[[W0:.*]]: tensor<8x8x3x3xf32>,
+// CHECK:   %[[W1:.*]]: tensor<8x8x3x3xf32>
+// CHECK: )
+// CHECK:   %[[R0:.*]] = cudnn.call @conv_relu(%[[X]], %[[W0]])
+// CHECK:   %[[R1:.*]] = cudnn.call @conv_relu(%[[R0]], %[[W1]])
+// CHECK:   return %[[R1]]
+
+// CHECK:     cudnn.graph @conv_relu(
+// CHECK-NOT: cudnn.graph
+
+// -----
+
+// Transformer MLP block: matmul with shared 2-D weights followed by bias add
+// and GELU (tanh approximation) is fused into a single cuDNN graph.
+func.func @matmul_bias_gelu(%x: tensor<4x128x256xf16>, %w: tensor<256x512xf16>,
+                            %b: tensor<512xf16>) -> tensor<4x128x512xf16> {
+  %half = stablehlo.constant dense<0.5> : tensor<4x128x512xf16>
+  %one = stablehlo.constant dense<1.0> : tensor<4x128x512xf16>
+  %sqrt_2_pi = stablehlo.constant dense<0.797884583> : tensor<4x128x512xf16>
+  %coeff = stablehlo.constant dense<0.044715> : tensor<4x128x512xf16>
+  %dot = "stablehlo.dot_general"(%x, %w) {
+    dot_dimension_numbers = #stablehlo.dot<
+      lhs_contracting_dimensions = [2],
+      rhs_contracting_dimensions = [0]>
+  } : (tensor<4x128x256xf16>, tensor<256x512xf16>) -> tensor<4x128x512xf16>
+  %bias = "stablehlo.broadcast_in_dim"(%b) {
+    broadcast_dimensions = dense<[2]> : tensor<1xi64>
+  } : (tensor<512xf16>) -> tensor<4x128x512xf16>
+  %y = stablehlo.add %dot, %bias : tensor<4x128x512xf16>
+  %y2 = stablehlo.multiply %y, %y : tensor<4x128x512xf16>
+  %y3 = stablehlo.multiply %y, %y2 : tensor<4x128x512xf16>
+  %0 = stablehlo.multiply %coeff, %y3 : tensor<4x128x512xf16>
+  %1 = stablehlo.add %y, %0 : tensor<4x128x512xf16>
+  %2 = stablehlo.multiply %sqrt_2_pi, %1 : tensor<4x128x512xf16>
+  %3 = stablehlo.tanh %2 : tensor<4x128x512xf16>
+  %4 = stablehlo.add %one, %3 : tensor<4x128x512xf16>
+  %cdf = stablehlo.multiply %half, %4 : tensor<4x128x512xf16>
+  %gelu = stablehlo.multiply %y, %cdf : tensor<4x128x512xf16>
+  return %gelu : tensor<4x128x512xf16>
+}
+
+// CHECK-LABEL: func.func @matmul_bias_gelu(
+// CHECK:   %[[X:.*]]: tensor<4x128x256xf16>, %[[W:.*]]: tensor<256x512xf16>,
+// CHECK:   %[[B:.*]]: tensor<512xf16>
+// CHECK: )
+// CHECK:   %[[W3:.*]] = stablehlo.reshape %[[W]]
+// CHECK-SAME: (tensor<256x512xf16>) -> tensor<1x256x512xf16>
+// CHECK:   %[[B3:.*]] = stablehlo.reshape %[[B]]
+// CHECK-SAME: (tensor<512xf16>) -> tensor<1x1x512xf16>
+// CHECK:   %[[RES:.*]] = cudnn.call @matmul_bias_gelu(%[[X]], %[[W3]], %[[B3]])
+// CHECK-NOT: stablehlo.dot_general
+// CHECK-NOT: stablehlo.tanh
+// CHECK-NOT: stablehlo.multiply
+// CHECK:   return %[[RES]]
+
+// CHECK: cudnn.graph @matmul_bias_gelu(
+// CHECK-SAME: %[[ARG0:.*]]: !cudnn.tensor<4x128x256xf16>,
+// CHECK-SAME: %[[ARG1:.*]]: !cudnn.tensor<1x256x512xf16>,
+// CHECK-SAME: %[[ARG2:.*]]: !cudnn.tensor<1x1x512xf16>
+// CHECK-SAME: ) -> !cudnn.tensor<4x128x512xf16>
+// CHECK:   %[[MATMUL:.*]] = cudnn.matmul(%[[ARG0]], %[[ARG1]]) type = f32
+// CHECK:   %[[BIAS:.*]] = cudnn.pointwise_add(%[[MATMUL]], %[[ARG2]])
+// CHECK:   %[[GELU:.*]] = cudnn.pointwise_gelu(%[[BIAS]]) type = f32
+// CHECK:   cudnn.return %[[GELU]]
+
+// -----
+
+// Batched matmul with transposed rhs is passed to cuDNN with strides.
+func.func @batch_matmul(%a: tensor<8x64x32xf32>,
+                        %b: tensor<8x16x32xf32>) -> tensor<8x64x16xf32> {
+  %0 = "stablehlo.dot_general"(%a, %b) {
+    dot_dimension_numbers = #stablehlo.dot<
+      lhs_batching_dimensions = [0],
+      rhs_batching_dimensions = [0],
+      lhs_contracting_dimensions = [2],
+      rhs_contracting_dimensions = [2]>
+  } : (tensor<8x64x32xf32>, tensor<8x16x32xf32>) -> tensor<8x64x16xf32>
+  %zero = stablehlo.constant dense<0.0> : tensor<8x64x16xf32>
+  %1 = stablehlo.maximum %0, %zero : tensor<8x64x16xf32>
+  return %1 : tensor<8x64x16xf32>
+}
+
+// CHECK-LABEL: func.func @batch_matmul(
+// CHECK:   %[[A:.*]]: tensor<8x64x32xf32>, %[[B:.*]]: tensor<8x16x32xf32>
+// CHECK: )
+// CHECK:   %[[RES:.*]] = cudnn.call @matmul_relu(%[[A]], %[[B]])
+// CHECK:   return %[[RES]]
+
+// CHECK: cudnn.graph @matmul_relu(
+// CHECK-SAME: !cudnn.tensor<8x64x32xf32>,
+// CHECK-SAME: !cudnn.tensor<8x32x16xf32, affine_map<(d0, d1, d2) -> (d0, d2, d1)>>
+// CHECK:   cudnn.matmul
+// CHECK:   cudnn.pointwise_relu
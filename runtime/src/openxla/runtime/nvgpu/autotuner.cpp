@@ -0,0 +1,55 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/autotuner.h"
+
+#include <algorithm>
+
+namespace openxla::runtime::nvgpu {
+
+using namespace iree;
+
+StatusOr<AutotuneResult> Autotune(size_t num_candidates,
+                                  const AutotuneOptions& options,
+                                  AutotuneTimer& timer) {
+  if (num_candidates == 0)
+    return Status(StatusCode::kInvalidArgument, "no candidates to autotune");
+  if (options.max_candidates <= 0 || options.iterations <= 0 ||
+      options.warmup_iterations < 0)
+    return Status(StatusCode::kInvalidArgument, "invalid autotuning options");
+
+  size_t num_measured =
+      std::min(num_candidates, static_cast<size_t>(options.max_candidates));
+
+  AutotuneResult result;
+  std::optional<float> best_time_ms;
+
+  for (size_t i = 0; i < num_measured; ++i) {
+    StatusOr<float> time_ms =
+        timer.Measure(i, options.warmup_iterations, options.iterations);
+
+    // Candidate can fail at run time (e.g. if it requires more resources than
+    // available), we skip it and keep measuring the remaining ones.
+    if (!time_ms.ok()) {
+      result.times_ms.push_back(std::nullopt);
+      continue;
+    }
+
+    result.times_ms.push_back(*time_ms);
+    if (!best_time_ms || *time_ms < *best_time_ms) {
+      best_time_ms = *time_ms;
+      result.selected = i;
+    }
+  }
+
+  if (!best_time_ms)
+    return Status(StatusCode::kUnavailable,
+                  "all autotuning candidates failed to run");
+
+  return result;
+}
+
+}  // namespace openxla::runtime::nvgpu
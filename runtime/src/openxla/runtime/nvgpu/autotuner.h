@@ -0,0 +1,73 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef OPENXLA_RUNTIME_NVGPU_AUTOTUNER_H_
+#define OPENXLA_RUNTIME_NVGPU_AUTOTUNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "iree/base/status_cc.h"
+
+namespace openxla::runtime::nvgpu {
+
+// Empirical autotuning runs candidate execution plans suggested by cuDNN
+// heuristics and selects the fastest one. Heuristics are not always accurate
+// (e.g. for NHWC fp16 convolutions), and measuring the actual execution time
+// on the target device is the only reliable way to find the best engine.
+
+struct AutotuneOptions {
+  // Maximum number of candidates (in the heuristics order) to measure. Zero
+  // disables autotuning.
+  int64_t max_candidates = 0;
+
+  // Number of untimed runs of each candidate before measurement (e.g. to load
+  // kernels and warm up caches).
+  int64_t warmup_iterations = 1;
+
+  // Number of timed runs of each candidate.
+  int64_t iterations = 10;
+
+  // Whether the selected candidate is recorded in the plan database.
+  bool persist = true;
+};
+
+// Measures the execution time of candidates. cuDNN module implements it by
+// running execution plans on scratch buffers and timing them with CUDA events,
+// and tests can use a fake timer to exercise the selection logic.
+class AutotuneTimer {
+ public:
+  virtual ~AutotuneTimer() = default;
+
+  // Runs the candidate `warmup_iterations + iterations` times and returns the
+  // average execution time of timed iterations in milliseconds.
+  virtual iree::StatusOr<float> Measure(size_t candidate,
+                                        int64_t warmup_iterations,
+                                        int64_t iterations) = 0;
+};
+
+struct AutotuneResult {
+  // Index of the fastest candidate.
+  size_t selected = 0;
+
+  // Average execution time of all measured candidates in milliseconds, or
+  // nullopt if the candidate failed to run.
+  std::vector<std::optional<float>> times_ms;
+};
+
+// Measures up to `options.max_candidates` of `num_candidates` candidates and
+// returns the fastest one. Candidates that failed to run are skipped, and ties
+// are broken in favor of the earlier candidate (preferred by heuristics).
+// Returns an error if none of the candidates can be measured.
+iree::StatusOr<AutotuneResult> Autotune(size_t num_candidates,
+                                        const AutotuneOptions& options,
+                                        AutotuneTimer& timer);
+
+}  // namespace openxla::runtime::nvgpu
+
+#endif  // OPENXLA_RUNTIME_NVGPU_AUTOTUNER_H_
@@ -12,7 +12,15 @@
 #include <iree/vm/ref_cc.h>
 #include <openxla/runtime/nvgpu/status_util.h>
 
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "openxla/runtime/nvgpu/cudnn_stub.h"
 
@@ -27,45 +35,107 @@ using cudnn_frontend::TensorBuilder;
 // clang-format on
 
 //===----------------------------------------------------------------------===//
-// CuDNNArgTensor.
+// Fingerprints of cuDNN tensors and operation graphs.
 //===----------------------------------------------------------------------===//
 
-CuDNNArgTensor::CuDNNArgTensor(openxla_cudnn_dynamic_symbols_t* syms,
-                               cudnn_frontend::Tensor tensor)
-    : CuDNNTensor(Kind::kArg), syms_(syms), tensor_(std::move(tensor)) {}
+static uint64_t HashCombine(uint64_t seed, uint64_t value) {
+  return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+template <typename T>
+static uint64_t HashValue(T value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    double dvalue = value;
+    uint64_t bits;
+    std::memcpy(&bits, &dvalue, sizeof(bits));
+    return bits;
+  } else {
+    return static_cast<uint64_t>(value);
+  }
+}
+
+static uint64_t TensorFingerprint(const cudnn_frontend::Tensor& tensor) {
+  int64_t rank = tensor.getDimensionCount();
+  uint64_t hash = HashValue(rank);
+  for (int64_t i = 0; i < rank; ++i) {
+    hash = HashCombine(hash, HashValue(tensor.getDimArray()[i]));
+    hash = HashCombine(hash, HashValue(tensor.getStrideArray()[i]));
+  }
+  hash = HashCombine(hash, HashValue(tensor.getDataType()));
+  hash = HashCombine(hash, HashValue(tensor.getAlignment()));
+  hash = HashCombine(hash, HashValue(tensor.getId()));
+  hash = HashCombine(hash, HashValue(tensor.isVirtualTensor()));
+  hash = HashCombine(hash, HashValue(tensor.isByValue()));
+  return hash;
+}
 
-CuDNNArgTensor::~CuDNNArgTensor() {
-  ScopedCuDNNStubs stubs(syms_);
-  tensor_.reset();
+static uint64_t ScalarFingerprint(const cudnn_frontend::Tensor& tensor,
+                                  CuDNNScalarTensor::Value value) {
+  return HashCombine(TensorFingerprint(tensor), HashValue(value.i64));
 }
 
+// Computes fingerprint of the operation result from the operation kind and
+// attributes, fingerprints of all operation inputs and the result tensor.
+template <typename... Attrs>
+static uint64_t OpResultFingerprint(span<CuDNNTensor* const> inputs,
+                                    const cudnn_frontend::Tensor& result,
+                                    Attrs... attrs) {
+  uint64_t hash = TensorFingerprint(result);
+  ((hash = HashCombine(hash, HashValue(attrs))), ...);
+  for (CuDNNTensor* input : inputs)
+    hash = HashCombine(hash, input->fingerprint());
+  return hash;
+}
+
+static uint64_t GraphFingerprint(span<CuDNNTensor* const> results) {
+  uint64_t hash = HashValue(results.size());
+  for (CuDNNTensor* result : results)
+    hash = HashCombine(hash, result->fingerprint());
+  return hash;
+}
+
+//===----------------------------------------------------------------------===//
+// CuDNNArgTensor.
+//===----------------------------------------------------------------------===//
+
+CuDNNArgTensor::CuDNNArgTensor(cudnn_frontend::Tensor tensor)
+    : CuDNNTensor(Kind::kArg, TensorFingerprint(tensor)),
+      tensor_(std::move(tensor)) {}
+
 const cudnn_frontend::Tensor& CuDNNArgTensor::tensor() const {
   return *tensor_;
 }
 
+//===----------------------------------------------------------------------===//
+// CuDNNScalarTensor.
+//===----------------------------------------------------------------------===//
+
+CuDNNScalarTensor::CuDNNScalarTensor(cudnn_frontend::Tensor tensor,
+                                     Value value)
+    : CuDNNTensor(Kind::kScalar, ScalarFingerprint(tensor, value)),
+      tensor_(std::move(tensor)),
+      value_(value) {}
+
+const cudnn_frontend::Tensor& CuDNNScalarTensor::tensor() const {
+  return *tensor_;
+}
+
 //===----------------------------------------------------------------------===//
 // CuDNNOpResultTensor.
 //===----------------------------------------------------------------------===//
 
-CuDNNOpResultTensor::CuDNNOpResultTensor(openxla_cudnn_dynamic_symbols_t* syms,
-                                         iree::span<CuDNNTensor* const> inputs,
-                                         cudnn_frontend::Operation operation,
-                                         cudnn_frontend::Tensor tensor)
-    : CuDNNTensor(Kind::kOpResult),
-      syms_(syms),
+CuDNNOpResultTensor::CuDNNOpResultTensor(
+    iree::span<CuDNNTensor* const> inputs, cudnn_frontend::Operation operation,
+    cudnn_frontend::Tensor tensor, uint64_t fingerprint, Builder builder)
+    : CuDNNTensor(Kind::kOpResult, fingerprint),
       operation_(std::move(operation)),
-      tensor_(std::move(tensor)) {
+      tensor_(std::move(tensor)),
+      builder_(std::move(builder)) {
   for (CuDNNTensor* input : inputs) {
     inputs_.push_back(vm::retain_ref(input));
   }
 }
 
-CuDNNOpResultTensor::~CuDNNOpResultTensor() {
-  ScopedCuDNNStubs stubs(syms_);
-  operation_.reset();
-  tensor_.reset();
-}
-
 std::vector<CuDNNTensor*> CuDNNOpResultTensor::inputs() const {
   std::vector<CuDNNTensor*> ptrs;
   for (auto& input : inputs_) ptrs.push_back(input.get());
@@ -84,23 +154,200 @@ const cudnn_frontend::Tensor& CuDNNOpResultTensor::tensor() const {
 // CuDNNOperationGraph.
 //===----------------------------------------------------------------------===//
 
-CuDNNOperationGraph::CuDNNOperationGraph(openxla_cudnn_dynamic_symbols_t* syms,
-                                         cudnn_frontend::OperationGraph graph)
-    : syms_(syms), graph_(std::move(graph)) {}
+CuDNNOperationGraph::CuDNNOperationGraph(
+    cudnn_frontend::OperationGraph graph,
+    std::vector<vm::ref<CuDNNTensor>> args,
+    std::vector<vm::ref<CuDNNTensor>> rets,
+    std::vector<vm::ref<CuDNNTensor>> scalars,
+    std::deque<cudnn_frontend::Tensor> virtual_tensors,
+    std::deque<cudnn_frontend::Operation> operations, uint64_t fingerprint)
+    : graph_(std::move(graph)),
+      args_(std::move(args)),
+      rets_(std::move(rets)),
+      scalars_(std::move(scalars)),
+      virtual_tensors_(std::move(virtual_tensors)),
+      operations_(std::move(operations)),
+      fingerprint_(fingerprint) {
+  for (auto* tensors : {&args_, &rets_}) {
+    for (vm::ref<CuDNNTensor>& tensor : *tensors) {
+      uids_.push_back(tensor->tensor().getId());
+      tensors_.push_back(tensor.get());
+    }
+  }
+  for (vm::ref<CuDNNTensor>& scalar : scalars_) {
+    scalar_uids_.push_back(scalar->tensor().getId());
+    auto* value = static_cast<CuDNNScalarTensor*>(scalar.get());
+    scalar_ptrs_.push_back(value->data());
+  }
+}
 
 CuDNNOperationGraph::~CuDNNOperationGraph() {
-  ScopedCuDNNStubs stubs(syms_);
   graph_.reset();
+  operations_.clear();
+  virtual_tensors_.clear();
+}
+
+cudnn_frontend::OperationGraph& CuDNNOperationGraph::graph() {
+  return *graph_;
 }
 
 const cudnn_frontend::OperationGraph& CuDNNOperationGraph::graph() const {
   return *graph_;
 }
 
+const std::vector<vm::ref<CuDNNTensor>>& CuDNNOperationGraph::args() const {
+  return args_;
+}
+
+const std::vector<vm::ref<CuDNNTensor>>& CuDNNOperationGraph::rets() const {
+  return rets_;
+}
+
+const std::vector<int64_t>& CuDNNOperationGraph::uids() const { return uids_; }
+
+const std::vector<const CuDNNTensor*>& CuDNNOperationGraph::tensors() const {
+  return tensors_;
+}
+
+//===----------------------------------------------------------------------===//
+// CuDNNExecutable.
+//===----------------------------------------------------------------------===//
+
+CuDNNExecutable::CuDNNExecutable(
+    openxla_cudnn_dynamic_symbols_t* syms, CuDNNOperationGraph& graph,
+    std::vector<cudnn_frontend::ExecutionPlan> plans,
+    std::vector<CuDNNEngineConfig> engine_configs,
+    CuDNNWorkspaceLimitReport workspace_limit_report)
+    : syms_(syms),
+      graph_(vm::retain_ref(&graph)),
+      plans_(std::move(plans)),
+      engine_configs_(std::move(engine_configs)),
+      workspace_limit_report_(workspace_limit_report) {}
+
+CuDNNExecutable::~CuDNNExecutable() {
+  variant_packs_.Clear();
+  plans_.clear();
+}
+
+const CuDNNOperationGraph& CuDNNExecutable::graph() const { return *graph_; }
+
+const std::vector<cudnn_frontend::ExecutionPlan>& CuDNNExecutable::plans()
+    const {
+  return plans_;
+}
+
+const std::vector<CuDNNEngineConfig>& CuDNNExecutable::engine_configs() const {
+  return engine_configs_;
+}
+
+const CuDNNWorkspaceLimitReport& CuDNNExecutable::workspace_limit_report()
+    const {
+  return workspace_limit_report_;
+}
+
+void CuDNNExecutable::SelectPlan(size_t index) {
+  IREE_ASSERT(index < plans_.size());
+  std::rotate(plans_.begin(), plans_.begin() + index,
+              plans_.begin() + index + 1);
+  std::rotate(engine_configs_.begin(), engine_configs_.begin() + index,
+              engine_configs_.begin() + index + 1);
+}
+
+Status CuDNNExecutable::Execute(cudnnHandle_t handle, size_t plan_index,
+                                span<void* const> buffers,
+                                void* workspace) const {
+  const std::vector<int64_t>& uids = graph_->uids();
+  if (buffers.size() != uids.size())
+    return Status(StatusCode::kInvalidArgument,
+                  "number of buffers does not match the number of graph "
+                  "tensors");
+
+  auto create = [&](span<void* const> ptrs,
+                    void* workspace) -> StatusOr<cudnn_frontend::VariantPack> {
+    // By-value scalars are bound from the host memory owned by the graph after
+    // all device buffers.
+    std::vector<void*> data_ptrs(ptrs.begin(), ptrs.end());
+    std::vector<int64_t> data_uids(uids.begin(), uids.end());
+    data_ptrs.insert(data_ptrs.end(), graph_->scalar_ptrs().begin(),
+                     graph_->scalar_ptrs().end());
+    data_uids.insert(data_uids.end(), graph_->scalar_uids().begin(),
+                     graph_->scalar_uids().end());
+
+    cudnn_frontend::VariantPack variant_pack =
+        cudnn_frontend::VariantPackBuilder()
+            .setWorkspacePointer(workspace)
+            .setDataPointers(data_ptrs.size(), data_ptrs.data())
+            .setUids(data_uids.size(), data_uids.data())
+            .build();
+    IREE_RETURN_IF_ERROR(
+        CUDNN_CONVERT_STATUS(syms_, variant_pack.get_status()));
+    return variant_pack;
+  };
+
+  std::lock_guard<std::mutex> lock(mu_);
+  IREE_ASSIGN_OR_RETURN(const cudnn_frontend::VariantPack* variant_pack,
+                        variant_packs_.GetOrCreate(buffers, workspace, create));
+
+  CUDNN_RETURN_IF_ERROR(
+      syms_,
+      cudnnBackendExecute(handle, plans_[plan_index].get_raw_desc(),
+                          variant_pack->get_raw_desc()),
+      "cudnnBackendExecute");
+  return OkStatus();
+}
+
+size_t CuDNNExecutable::ApproximateSizeInBytes() const {
+  // Backend descriptors of execution plans can own run time compiled kernels,
+  // which are typically the largest part of the executable footprint.
+  static constexpr size_t kExecutionPlanSizeEstimate = 64 * 1024;
+  return sizeof(CuDNNExecutable) + plans_.size() * kExecutionPlanSizeEstimate;
+}
+
 //===----------------------------------------------------------------------===//
 // Wrappers around cuDNN APIs export from a cuDNN module to the user.
 //===----------------------------------------------------------------------===//
 
+//===----------------------------------------------------------------------===//
+// GetTensorSizeInBytes.
+//===----------------------------------------------------------------------===//
+
+static StatusOr<size_t> GetElementSizeInBytes(cudnnDataType_t dtype) {
+  switch (dtype) {
+    case CUDNN_DATA_INT8:
+    case CUDNN_DATA_UINT8:
+    case CUDNN_DATA_FP8_E4M3:
+    case CUDNN_DATA_FP8_E5M2:
+      return 1;
+    case CUDNN_DATA_HALF:
+    case CUDNN_DATA_BFLOAT16:
+      return 2;
+    case CUDNN_DATA_FLOAT:
+    case CUDNN_DATA_INT32:
+      return 4;
+    case CUDNN_DATA_DOUBLE:
+    case CUDNN_DATA_INT64:
+      return 8;
+    default:
+      return Status(StatusCode::kUnimplemented,
+                    "unsupported cuDNN tensor data type");
+  }
+}
+
+StatusOr<size_t> GetTensorSizeInBytes(const CuDNNTensor& tensor) {
+  const cudnn_frontend::Tensor& desc = tensor.tensor();
+  IREE_ASSIGN_OR_RETURN(
+      size_t element_size,
+      GetElementSizeInBytes(static_cast<cudnnDataType_t>(desc.getDataType())));
+
+  // Offset of the last element plus one (tensors can have non-dense strides).
+  size_t num_elements = 1;
+  for (int64_t i = 0; i < desc.getDimensionCount(); ++i) {
+    if (desc.getDimArray()[i] == 0) return 0;
+    num_elements += (desc.getDimArray()[i] - 1) * desc.getStrideArray()[i];
+  }
+  return num_elements * element_size;
+}
+
 //===----------------------------------------------------------------------===//
 // CreateArgument.
 //===----------------------------------------------------------------------===//
@@ -109,7 +356,6 @@ StatusOr<vm::ref<CuDNNTensor>> CreateArgument(
     openxla_cudnn_dynamic_symbols_t* syms, span<const int64_t> dims,
     span<const int64_t> strides, int64_t uid, cudnnDataType_t dtype,
     int64_t alignment) {
-  ScopedCuDNNStubs stubs(syms);
   cudnn_frontend::Tensor tensor = cudnn_frontend::TensorBuilder()
                                       .setDim(dims.size(), dims.data())
                                       .setStride(strides.size(), strides.data())
@@ -118,45 +364,427 @@ StatusOr<vm::ref<CuDNNTensor>> CreateArgument(
                                       .setDataType(dtype)
                                       .build();
   IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, tensor.get_status()));
-  return vm::ref<CuDNNTensor>(new CuDNNArgTensor(syms, std::move(tensor)));
+  return vm::ref<CuDNNTensor>(new CuDNNArgTensor(std::move(tensor)));
+}
+
+//===----------------------------------------------------------------------===//
+// CreateScalar.
+//===----------------------------------------------------------------------===//
+
+static std::vector<const cudnn_frontend::Tensor*> GetDescriptors(
+    span<CuDNNTensor* const> tensors) {
+  std::vector<const cudnn_frontend::Tensor*> descs;
+  for (CuDNNTensor* tensor : tensors) descs.push_back(&tensor->tensor());
+  return descs;
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CreateScalar(
+    openxla_cudnn_dynamic_symbols_t* syms, cudnnDataType_t dtype, double value,
+    int64_t rank, int64_t uid) {
+  CuDNNScalarTensor::Value scalar;
+  scalar.i64 = 0;
+  switch (dtype) {
+    case CUDNN_DATA_FLOAT:
+      scalar.f32 = static_cast<float>(value);
+      break;
+    case CUDNN_DATA_DOUBLE:
+      scalar.f64 = value;
+      break;
+    case CUDNN_DATA_INT32:
+      scalar.i32 = static_cast<int32_t>(value);
+      break;
+    case CUDNN_DATA_INT64:
+      scalar.i64 = static_cast<int64_t>(value);
+      break;
+    default:
+      return Status(StatusCode::kUnimplemented,
+                    "unsupported cuDNN scalar data type");
+  }
+
+  if (rank < 1 || rank > CUDNN_DIM_MAX)
+    return Status(StatusCode::kInvalidArgument, "unsupported scalar rank");
+
+  // Scalars are broadcasted to all dimensions of other pointwise inputs.
+  std::vector<int64_t> ones(rank, 1);
+  cudnn_frontend::Tensor tensor = cudnn_frontend::TensorBuilder()
+                                      .setDim(rank, ones.data())
+                                      .setStride(rank, ones.data())
+                                      .setId(uid)
+                                      .setAlignment(sizeof(scalar))
+                                      .setDataType(dtype)
+                                      .setByValue(true)
+                                      .build();
+  IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, tensor.get_status()));
+
+  return vm::ref<CuDNNTensor>(
+      new CuDNNScalarTensor(std::move(tensor), scalar));
 }
 
 //===----------------------------------------------------------------------===//
-// CreatePointwiseRelu.
+// CreatePointwise.
 //===----------------------------------------------------------------------===//
 
+static bool IsPredicateMode(cudnnPointwiseMode_t mode) {
+  switch (mode) {
+    case CUDNN_POINTWISE_CMP_EQ:
+    case CUDNN_POINTWISE_CMP_NEQ:
+    case CUDNN_POINTWISE_CMP_GT:
+    case CUDNN_POINTWISE_CMP_GE:
+    case CUDNN_POINTWISE_CMP_LT:
+    case CUDNN_POINTWISE_CMP_LE:
+    case CUDNN_POINTWISE_LOGICAL_AND:
+    case CUDNN_POINTWISE_LOGICAL_OR:
+    case CUDNN_POINTWISE_LOGICAL_NOT:
+      return true;
+    default:
+      return false;
+  }
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CreatePointwise(
+    openxla_cudnn_dynamic_symbols_t* syms, cudnnPointwiseMode_t mode,
+    span<CuDNNTensor* const> inputs, int64_t uid, int64_t alignment,
+    const CuDNNPointwiseAttrs& attrs) {
+  if (inputs.empty() || inputs.size() > 3)
+    return Status(StatusCode::kInvalidArgument,
+                  "pointwise operation must have one to three inputs");
+  if (inputs.size() == 3 && mode != CUDNN_POINTWISE_BINARY_SELECT)
+    return Status(StatusCode::kInvalidArgument,
+                  "only select pointwise operation has three inputs");
+
+  // Compute the result shape by broadcasting unit dimensions of all inputs.
+  int64_t rank = inputs[0]->tensor().getDimensionCount();
+  std::vector<int64_t> dims(rank, 1);
+  for (CuDNNTensor* input : inputs) {
+    const cudnn_frontend::Tensor& desc = input->tensor();
+    if (desc.getDimensionCount() != rank)
+      return Status(StatusCode::kInvalidArgument,
+                    "pointwise operation inputs must have the same rank");
+
+    for (int64_t i = 0; i < rank; ++i) {
+      int64_t dim = desc.getDimArray()[i];
+      if (dim != dims[i] && dim != 1 && dims[i] != 1)
+        return Status(StatusCode::kInvalidArgument,
+                      "pointwise operation inputs are not broadcastable");
+      dims[i] = std::max(dims[i], dim);
+    }
+  }
+
+  // Result takes the layout of the first device input with the result shape,
+  // or falls back to the row major layout if all inputs are broadcasted.
+  const CuDNNTensor* layout = nullptr;
+  for (CuDNNTensor* input : inputs) {
+    if (input->kind() == CuDNNTensor::Kind::kScalar) continue;
+    const int64_t* input_dims = input->tensor().getDimArray();
+    if (std::equal(dims.begin(), dims.end(), input_dims)) {
+      layout = input;
+      break;
+    }
+  }
+
+  std::vector<int64_t> strides(rank, 1);
+  if (layout) {
+    const int64_t* layout_strides = layout->tensor().getStrideArray();
+    strides.assign(layout_strides, layout_strides + rank);
+  } else {
+    for (int64_t i = rank - 2; i >= 0; --i)
+      strides[i] = strides[i + 1] * dims[i + 1];
+  }
+
+  // Prepare tensor descriptor for the pointwise operation output.
+  const cudnn_frontend::Tensor& x = inputs[0]->tensor();
+  cudnnDataType_t dtype = IsPredicateMode(mode)
+                              ? CUDNN_DATA_BOOLEAN
+                              : static_cast<cudnnDataType_t>(x.getDataType());
+  cudnn_frontend::Tensor tensor = cudnn_frontend::TensorBuilder()
+                                      .cloneFrom(x, uid)
+                                      .setDim(rank, dims.data())
+                                      .setStride(rank, strides.data())
+                                      .setDataType(dtype)
+                                      .setByValue(false)
+                                      .setVirtual(false)
+                                      .setAlignment(alignment)
+                                      .build();
+  IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, tensor.get_status()));
+
+  CuDNNOpResultTensor::Builder build =
+      [syms, mode, attrs](span<const cudnn_frontend::Tensor* const> inputs,
+                          const cudnn_frontend::Tensor& y)
+      -> StatusOr<cudnn_frontend::Operation> {
+    // Prepare pointwise descriptor.
+    cudnn_frontend::PointWiseDesc pointwise =
+        cudnn_frontend::PointWiseDescBuilder()
+            .setMode(mode)
+            .setClipping(attrs.lower_clip, attrs.upper_clip)
+            .setReluLowerClipSlope(attrs.lower_clip_slope)
+            .setEluAlpha(attrs.elu_alpha)
+            .setSoftplusBeta(attrs.softplus_beta)
+            .setSwishBeta(attrs.swish_beta)
+            .build();
+    IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, pointwise.get_status()));
+
+    // Create operation.
+    cudnn_frontend::OperationBuilder builder(
+        CUDNN_BACKEND_OPERATION_POINTWISE_DESCRIPTOR);
+    builder.setxDesc(*inputs[0]).setyDesc(y).setpwDesc(pointwise);
+    if (inputs.size() > 1) builder.setbDesc(*inputs[1]);
+    if (inputs.size() > 2) builder.settDesc(*inputs[2]);
+
+    cudnn_frontend::Operation operation = builder.build();
+    IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, operation.get_status()));
+    return operation;
+  };
+  IREE_ASSIGN_OR_RETURN(cudnn_frontend::Operation operation,
+                        build(GetDescriptors(inputs), tensor));
+
+  uint64_t fingerprint = OpResultFingerprint(
+      inputs, tensor, mode, attrs.lower_clip, attrs.upper_clip,
+      attrs.lower_clip_slope, attrs.elu_alpha, attrs.softplus_beta,
+      attrs.swish_beta);
+
+  return vm::ref<CuDNNTensor>(new CuDNNOpResultTensor(
+      inputs, std::move(operation), std::move(tensor), fingerprint, build));
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CreatePointwiseAdd(
+    openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& lhs, CuDNNTensor& rhs,
+    int64_t uid, int64_t alignment) {
+  return CreatePointwise(syms, CUDNN_POINTWISE_ADD, {&lhs, &rhs}, uid,
+                         alignment);
+}
+
 StatusOr<vm::ref<CuDNNTensor>> CreatePointwiseRelu(
     openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& input,
     double lower_clip, double upper_clip, int64_t uid, int64_t alignment) {
-  ScopedCuDNNStubs stubs(syms);
+  CuDNNPointwiseAttrs attrs;
+  attrs.lower_clip = lower_clip;
+  attrs.upper_clip = upper_clip;
+  return CreatePointwise(syms, CUDNN_POINTWISE_RELU_FWD, {&input}, uid,
+                         alignment, attrs);
+}
 
-  // Prepare tensor descriptor for activation output.
+StatusOr<vm::ref<CuDNNTensor>> CreatePointwiseGelu(
+    openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& input, int64_t uid,
+    int64_t alignment) {
+  return CreatePointwise(syms, CUDNN_POINTWISE_GELU_APPROX_TANH_FWD, {&input},
+                         uid, alignment);
+}
+
+//===----------------------------------------------------------------------===//
+// CreateMatmul.
+//===----------------------------------------------------------------------===//
+
+StatusOr<vm::ref<CuDNNTensor>> CreateMatmul(
+    openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& a, CuDNNTensor& b,
+    int64_t uid, int64_t alignment) {
+  const cudnn_frontend::Tensor& a_desc = a.tensor();
+  const cudnn_frontend::Tensor& b_desc = b.tensor();
+  if (a_desc.getDimensionCount() != 3 || b_desc.getDimensionCount() != 3)
+    return Status(StatusCode::kInvalidArgument,
+                  "matmul operands must be 3-D [batch, rows, columns] tensors");
+
+  const int64_t* a_dims = a_desc.getDimArray();
+  const int64_t* b_dims = b_desc.getDimArray();
+  if (a_dims[2] != b_dims[1])
+    return Status(StatusCode::kInvalidArgument,
+                  "matmul contracting dimensions do not match");
+  if (b_dims[0] != a_dims[0] && b_dims[0] != 1)
+    return Status(StatusCode::kInvalidArgument,
+                  "matmul batch dimensions do not match");
+
+  // Prepare tensor descriptor for matmul output.
+  int64_t dims[] = {a_dims[0], a_dims[1], b_dims[2]};
+  int64_t strides[] = {dims[1] * dims[2], dims[2], 1};
+  cudnn_frontend::Tensor tensor = cudnn_frontend::TensorBuilder()
+                                      .cloneFrom(a_desc, uid)
+                                      .setDim(3, dims)
+                                      .setStride(3, strides)
+                                      .setAlignment(alignment)
+                                      .setVirtual(false)
+                                      .build();
+  IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, tensor.get_status()));
+
+  // cuDNN accumulates in fp32 for all floating point types except fp64.
+  cudnnDataType_t compute_type =
+      a_desc.getDataType() == CUDNN_DATA_DOUBLE ? CUDNN_DATA_DOUBLE
+                                                : CUDNN_DATA_FLOAT;
+
+  CuDNNOpResultTensor::Builder build =
+      [syms, compute_type](span<const cudnn_frontend::Tensor* const> inputs,
+                           const cudnn_frontend::Tensor& c)
+      -> StatusOr<cudnn_frontend::Operation> {
+    // Prepare matmul descriptor.
+    cudnn_frontend::MatMulDesc matmul = cudnn_frontend::MatMulDescBuilder()
+                                            .setComputeType(compute_type)
+                                            .build();
+    IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, matmul.get_status()));
+
+    // Create operation.
+    cudnn_frontend::Operation operation =
+        cudnn_frontend::OperationBuilder(
+            CUDNN_BACKEND_OPERATION_MATMUL_DESCRIPTOR)
+            .setaMatDesc(*inputs[0])
+            .setbMatDesc(*inputs[1])
+            .setcMatDesc(c)
+            .setmatmulDesc(matmul)
+            .build();
+    IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, operation.get_status()));
+    return operation;
+  };
+  IREE_ASSIGN_OR_RETURN(cudnn_frontend::Operation operation,
+                        build(GetDescriptors({&a, &b}), tensor));
+
+  uint64_t fingerprint = OpResultFingerprint(
+      {&a, &b}, tensor, CUDNN_BACKEND_OPERATION_MATMUL_DESCRIPTOR);
+
+  return vm::ref<CuDNNTensor>(new CuDNNOpResultTensor(
+      {&a, &b}, std::move(operation), std::move(tensor), fingerprint, build));
+}
+
+//===----------------------------------------------------------------------===//
+// CreateConvolution.
+//===----------------------------------------------------------------------===//
+
+// Returns dense strides for `dims` laid out in memory in the same order as the
+// dimensions of a tensor with `like` strides (from the largest stride to the
+// smallest one, ties broken by the logical order).
+static std::vector<int64_t> GetDenseStridesLike(span<const int64_t> dims,
+                                                const int64_t* like) {
+  std::vector<size_t> order(dims.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b) { return like[a] > like[b]; });
+
+  std::vector<int64_t> strides(dims.size());
+  int64_t stride = 1;
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    strides[*it] = stride;
+    stride *= dims[*it];
+  }
+  return strides;
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CreateConvolution(
+    openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& x, CuDNNTensor& w,
+    const CuDNNConvolutionAttrs& attrs, int64_t uid, int64_t alignment,
+    bool is_virtual) {
+  const cudnn_frontend::Tensor& x_desc = x.tensor();
+  const cudnn_frontend::Tensor& w_desc = w.tensor();
+  int64_t rank = x_desc.getDimensionCount();
+  if (rank != 4 && rank != 5)
+    return Status(StatusCode::kInvalidArgument,
+                  "convolution input must be a 4-D or 5-D tensor");
+  if (w_desc.getDimensionCount() != rank)
+    return Status(StatusCode::kInvalidArgument,
+                  "convolution input and filter must have the same rank");
+
+  size_t num_spatial_dims = rank - 2;
+  for (auto* values : {&attrs.strides, &attrs.pre_padding,
+                       &attrs.post_padding, &attrs.dilations}) {
+    if (values->size() != num_spatial_dims)
+      return Status(StatusCode::kInvalidArgument,
+                    "convolution attributes must have a value for each "
+                    "spatial dimension");
+  }
+
+  if (is_virtual && attrs.beta != 0.0)
+    return Status(StatusCode::kInvalidArgument,
+                  "convolution with a virtual result can't blend it with "
+                  "beta");
+
+  const int64_t* x_dims = x_desc.getDimArray();
+  const int64_t* w_dims = w_desc.getDimArray();
+
+  // Grouped convolution splits input channels into `C / w.C` groups, and each
+  // group computes `K / groups` output channels.
+  if (w_dims[1] <= 0 || x_dims[1] % w_dims[1] != 0)
+    return Status(StatusCode::kInvalidArgument,
+                  "convolution input channels must be a multiple of filter "
+                  "channels");
+  int64_t groups = x_dims[1] / w_dims[1];
+  if (w_dims[0] % groups != 0)
+    return Status(StatusCode::kInvalidArgument,
+                  "convolution output channels must be a multiple of the "
+                  "number of groups");
+
+  // Compute output dimensions: [N, K, (D,) H, W].
+  std::vector<int64_t> dims = {x_dims[0], w_dims[0]};
+  for (size_t i = 0; i < num_spatial_dims; ++i) {
+    int64_t padded = x_dims[i + 2] + attrs.pre_padding[i] +
+                     attrs.post_padding[i];
+    int64_t window = attrs.dilations[i] * (w_dims[i + 2] - 1) + 1;
+    if (attrs.strides[i] <= 0 || padded < window)
+      return Status(StatusCode::kInvalidArgument,
+                    "invalid convolution window");
+    dims.push_back((padded - window) / attrs.strides[i] + 1);
+  }
+  std::vector<int64_t> strides =
+      GetDenseStridesLike(dims, x_desc.getStrideArray());
+
+  // Prepare tensor descriptor for convolution output.
   cudnn_frontend::Tensor tensor = cudnn_frontend::TensorBuilder()
-                                      .cloneFrom(input.tensor(), uid)
+                                      .cloneFrom(x_desc, uid)
+                                      .setDim(rank, dims.data())
+                                      .setStride(rank, strides.data())
                                       .setAlignment(alignment)
+                                      .setVirtual(is_virtual)
                                       .build();
   IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, tensor.get_status()));
 
-  // Prepare activation descriptor.
-  cudnn_frontend::PointWiseDesc activation =
-      cudnn_frontend::PointWiseDescBuilder()
-          .setMode(CUDNN_POINTWISE_RELU_FWD)
-          .setClipping(lower_clip, upper_clip)
-          .build();
-  IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, activation.get_status()));
-
-  // Create operation.
-  cudnn_frontend::Operation operation =
-      cudnn_frontend::OperationBuilder(
-          CUDNN_BACKEND_OPERATION_POINTWISE_DESCRIPTOR)
-          .setxDesc(input.tensor())
-          .setyDesc(tensor)
-          .setpwDesc(activation)
-          .build();
-  IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, operation.get_status()));
+  // Integer convolutions accumulate in int32, and all floating point types
+  // except fp64 in fp32.
+  cudnnDataType_t compute_type = CUDNN_DATA_FLOAT;
+  if (x_desc.getDataType() == CUDNN_DATA_DOUBLE)
+    compute_type = CUDNN_DATA_DOUBLE;
+  if (x_desc.getDataType() == CUDNN_DATA_INT8)
+    compute_type = CUDNN_DATA_INT32;
+
+  CuDNNOpResultTensor::Builder build =
+      [syms, compute_type, attrs, num_spatial_dims](
+          span<const cudnn_frontend::Tensor* const> inputs,
+          const cudnn_frontend::Tensor& y)
+      -> StatusOr<cudnn_frontend::Operation> {
+    // Prepare convolution descriptor.
+    cudnn_frontend::ConvDesc conv =
+        cudnn_frontend::ConvDescBuilder()
+            .setComputeType(compute_type)
+            .setMathMode(attrs.mode)
+            .setSpatialDimCount(num_spatial_dims)
+            .setSpatialStride(num_spatial_dims, attrs.strides.data())
+            .setPrePadding(num_spatial_dims, attrs.pre_padding.data())
+            .setPostPadding(num_spatial_dims, attrs.post_padding.data())
+            .setDilation(num_spatial_dims, attrs.dilations.data())
+            .build();
+    IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, conv.get_status()));
+
+    // Create operation.
+    cudnn_frontend::Operation operation =
+        cudnn_frontend::OperationBuilder(
+            CUDNN_BACKEND_OPERATION_CONVOLUTION_FORWARD_DESCRIPTOR)
+            .setxDesc(*inputs[0])
+            .setwDesc(*inputs[1])
+            .setyDesc(y)
+            .setcDesc(conv)
+            .setAlpha(static_cast<float>(attrs.alpha))
+            .setBeta(static_cast<float>(attrs.beta))
+            .build();
+    IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, operation.get_status()));
+    return operation;
+  };
+  IREE_ASSIGN_OR_RETURN(cudnn_frontend::Operation operation,
+                        build(GetDescriptors({&x, &w}), tensor));
+
+  uint64_t fingerprint = OpResultFingerprint(
+      {&x, &w}, tensor, CUDNN_BACKEND_OPERATION_CONVOLUTION_FORWARD_DESCRIPTOR,
+      attrs.mode, attrs.alpha, attrs.beta);
+  for (auto* values : {&attrs.strides, &attrs.pre_padding,
+                       &attrs.post_padding, &attrs.dilations}) {
+    for (int64_t value : *values)
+      fingerprint = HashCombine(fingerprint, HashValue(value));
+  }
 
   return vm::ref<CuDNNTensor>(new CuDNNOpResultTensor(
-      syms, {&input}, std::move(operation), std::move(tensor)));
+      {&x, &w}, std::move(operation), std::move(tensor), fingerprint, build));
 }
 
 //===----------------------------------------------------------------------===//
@@ -171,25 +799,114 @@ static To* DynCast(CuDNNTensor* tensor) {
 StatusOr<vm::ref<CuDNNOperationGraph>> CreateOperationGraph(
     openxla_cudnn_dynamic_symbols_t* syms, cudnnHandle_t handle,
     span<CuDNNTensor* const> results) {
-  ScopedCuDNNStubs stubs(syms);
+  // Collect tensors computed by cuDNN operations in topological order
+  // (producers before consumers). Tensors can be shared by multiple operations
+  // (e.g. residual connections), so we track visited tensors to add each
+  // operation to the graph exactly once.
+  std::vector<CuDNNOpResultTensor*> op_results;
+  std::unordered_set<CuDNNTensor*> visited;
 
-  // Collect cuDNN operations producing tensor results.
-  std::vector<CuDNNTensor*> worklist(results.begin(), results.end());
-  std::vector<const cudnn_frontend::Operation*> ops;
+  // Graph arguments that must be bound to device memory at run time.
+  std::vector<vm::ref<CuDNNTensor>> args;
 
-  // TODO(ezhulenev): Take care of duplicate operations when traversing a tensor
-  // use-def chains (with an end-to-end test once we'll support them).
+  // By-value scalar tensors bound to the host memory.
+  std::vector<vm::ref<CuDNNTensor>> scalars;
+  std::unordered_set<CuDNNTensor*> result_set(results.begin(), results.end());
+
+  for (CuDNNTensor* result : results) {
+    if (result->tensor().isVirtualTensor())
+      return Status(StatusCode::kInvalidArgument,
+                    "virtual tensors can't be operation graph results");
+  }
+
+  // Iterative post-order traversal of tensor use-def chains. The boolean flag
+  // is set once all tensor inputs were pushed to the worklist, and we can add
+  // the operation computing it to the graph.
+  std::vector<std::pair<CuDNNTensor*, bool>> worklist;
+  for (auto it = results.rbegin(); it != results.rend(); ++it)
+    worklist.emplace_back(*it, false);
 
   while (!worklist.empty()) {
-    CuDNNTensor* tensor = worklist.back();
+    auto [tensor, expanded] = worklist.back();
     worklist.pop_back();
 
-    // Add cudnn_frontend operation and follow inputs.
-    if (auto* op_result = DynCast<CuDNNOpResultTensor>(tensor)) {
+    if (expanded) {
+      op_results.push_back(DynCast<CuDNNOpResultTensor>(tensor));
+      continue;
+    }
+
+    if (!visited.insert(tensor).second) continue;
+
+    // By-value scalars are bound from the host memory by the graph itself.
+    if (DynCast<CuDNNScalarTensor>(tensor)) {
+      scalars.push_back(vm::retain_ref(tensor));
+      continue;
+    }
+
+    // Graph arguments do not have producing operations.
+    auto* op_result = DynCast<CuDNNOpResultTensor>(tensor);
+    if (!op_result) {
+      args.push_back(vm::retain_ref(tensor));
+      continue;
+    }
+
+    // Revisit tensor after all of its inputs are added to the graph.
+    worklist.emplace_back(tensor, true);
+    std::vector<CuDNNTensor*> inputs = op_result->inputs();
+    for (auto it = inputs.rbegin(); it != inputs.rend(); ++it) {
+      if (!visited.count(*it)) worklist.emplace_back(*it, false);
+    }
+  }
+
+  auto by_uid = [](const vm::ref<CuDNNTensor>& a,
+                   const vm::ref<CuDNNTensor>& b) {
+    return a->tensor().getId() < b->tensor().getId();
+  };
+  std::sort(args.begin(), args.end(), by_uid);
+  std::sort(scalars.begin(), scalars.end(), by_uid);
+
+  // Intermediate tensors are never visible outside of the graph, so we replace
+  // them with virtual tensors and rebuild operations that use them. UIDs of
+  // virtual tensors are assigned after all UIDs used in the graph.
+  int64_t next_uid = 0;
+  for (CuDNNTensor* tensor : visited)
+    next_uid = std::max(next_uid, tensor->tensor().getId() + 1);
+
+  std::deque<cudnn_frontend::Tensor> virtual_tensors;
+  std::deque<cudnn_frontend::Operation> operations;
+  std::unordered_map<CuDNNTensor*, const cudnn_frontend::Tensor*> replaced;
+  std::vector<const cudnn_frontend::Operation*> ops;
+
+  for (CuDNNOpResultTensor* op_result : op_results) {
+    bool rebuild = false;
+
+    std::vector<const cudnn_frontend::Tensor*> inputs;
+    for (CuDNNTensor* input : op_result->inputs()) {
+      auto it = replaced.find(input);
+      rebuild |= it != replaced.end();
+      inputs.push_back(it != replaced.end() ? it->second : &input->tensor());
+    }
+
+    const cudnn_frontend::Tensor* result = &op_result->tensor();
+    if (!result_set.count(op_result) && !result->isVirtualTensor()) {
+      cudnn_frontend::Tensor tensor = cudnn_frontend::TensorBuilder()
+                                          .cloneFrom(*result, next_uid++)
+                                          .setVirtual(true)
+                                          .build();
+      IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, tensor.get_status()));
+      result = &virtual_tensors.emplace_back(std::move(tensor));
+      replaced[op_result] = result;
+      rebuild = true;
+    }
+
+    if (!rebuild) {
       ops.push_back(op_result->operation());
-      std::vector<CuDNNTensor*> inputs = op_result->inputs();
-      worklist.insert(worklist.end(), inputs.begin(), inputs.end());
+      continue;
     }
+
+    IREE_ASSIGN_OR_RETURN(cudnn_frontend::Operation operation,
+                          op_result->builder()(inputs, *result));
+    ops.push_back(&operations.emplace_back(std::move(operation)));
   }
 
   // Construct a cudnn_frontend operation graph.
@@ -199,8 +916,241 @@ StatusOr<vm::ref<CuDNNOperationGraph>> CreateOperationGraph(
                    .build();
   IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, graph.get_status()));
 
-  return vm::ref<CuDNNOperationGraph>(
-      new CuDNNOperationGraph(syms, std::move(graph)));
+  // Graph results are bound to device memory in the user-defined order (graph
+  // arguments passed as results are already bound as arguments).
+  std::vector<vm::ref<CuDNNTensor>> rets;
+  std::unordered_set<CuDNNTensor*> bound;
+  for (CuDNNTensor* result : results) {
+    if (DynCast<CuDNNOpResultTensor>(result) && bound.insert(result).second)
+      rets.push_back(vm::retain_ref(result));
+  }
+
+  return vm::ref<CuDNNOperationGraph>(new CuDNNOperationGraph(
+      std::move(graph), std::move(args), std::move(rets), std::move(scalars),
+      std::move(virtual_tensors), std::move(operations),
+      GraphFingerprint(results)));
+}
+
+//===----------------------------------------------------------------------===//
+// CreateExecutable.
+//===----------------------------------------------------------------------===//
+
+// Heuristics modes queried for engine configs in the order of preference.
+static constexpr cudnnBackendHeurMode_t kHeuristicsModes[] = {
+    CUDNN_HEUR_MODE_A, CUDNN_HEUR_MODE_B, CUDNN_HEUR_MODE_FALLBACK};
+
+// Maximum number of execution plans kept in the executable.
+static constexpr size_t kMaxExecutionPlans = 8;
+
+// Returns true if the engine config numerical notes are not compatible with
+// the expected numerical properties of an operation graph.
+static bool HasUnsupportedNumericalNotes(cudnnBackendDescriptor_t config) {
+  return cudnn_frontend::hasNumericalNote<
+             CUDNN_NUMERICAL_NOTE_DOWN_CONVERT_INPUTS>(config) ||
+         cudnn_frontend::hasNumericalNote<
+             CUDNN_NUMERICAL_NOTE_NONDETERMINISTIC>(config);
+}
+
+// Reads engine global index and knob choices from the engine config backend
+// descriptor.
+static StatusOr<CuDNNEngineConfig> GetEngineConfig(
+    openxla_cudnn_dynamic_symbols_t* syms, cudnnBackendDescriptor_t config) {
+  CuDNNEngineConfig engine_config;
+  int64_t count = 0;
+
+  // Get the engine global index.
+  auto engine = cudnn_frontend::make_shared_backend_pointer(
+      CUDNN_BACKEND_ENGINE_DESCRIPTOR);
+  IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, engine->get_status()));
+  cudnnBackendDescriptor_t engine_desc = engine->get_backend_descriptor();
+
+  CUDNN_RETURN_IF_ERROR(
+      syms, cudnnBackendGetAttribute(config, CUDNN_ATTR_ENGINECFG_ENGINE,
+                                     CUDNN_TYPE_BACKEND_DESCRIPTOR, 1, &count,
+                                     &engine_desc),
+      "cudnnBackendGetAttribute");
+  CUDNN_RETURN_IF_ERROR(
+      syms,
+      cudnnBackendGetAttribute(engine_desc, CUDNN_ATTR_ENGINE_GLOBAL_INDEX,
+                               CUDNN_TYPE_INT64, 1, &count,
+                               &engine_config.engine_id),
+      "cudnnBackendGetAttribute");
+
+  // Get all knob choices set in the engine config.
+  std::vector<cudnn_frontend::ManagedOpaqueDescriptor> choices;
+  std::vector<cudnnBackendDescriptor_t> choices_desc;
+  for (int i = 0; i < CUDNN_KNOB_TYPE_COUNTS; ++i) {
+    choices.push_back(cudnn_frontend::make_shared_backend_pointer(
+        CUDNN_BACKEND_KNOB_CHOICE_DESCRIPTOR));
+    IREE_RETURN_IF_ERROR(
+        CUDNN_CONVERT_STATUS(syms, choices.back()->get_status()));
+    choices_desc.push_back(choices.back()->get_backend_descriptor());
+  }
+
+  int64_t num_choices = 0;
+  CUDNN_RETURN_IF_ERROR(
+      syms, cudnnBackendGetAttribute(config, CUDNN_ATTR_ENGINECFG_KNOB_CHOICES,
+                                     CUDNN_TYPE_BACKEND_DESCRIPTOR,
+                                     choices_desc.size(), &num_choices,
+                                     choices_desc.data()),
+      "cudnnBackendGetAttribute");
+
+  for (int64_t i = 0; i < num_choices; ++i) {
+    cudnnBackendKnobType_t type;
+    int64_t value;
+    CUDNN_RETURN_IF_ERROR(
+        syms, cudnnBackendGetAttribute(choices_desc[i],
+                                       CUDNN_ATTR_KNOB_CHOICE_KNOB_TYPE,
+                                       CUDNN_TYPE_KNOB_TYPE, 1, &count, &type),
+        "cudnnBackendGetAttribute");
+    CUDNN_RETURN_IF_ERROR(
+        syms, cudnnBackendGetAttribute(choices_desc[i],
+                                       CUDNN_ATTR_KNOB_CHOICE_KNOB_VALUE,
+                                       CUDNN_TYPE_INT64, 1, &count, &value),
+        "cudnnBackendGetAttribute");
+    engine_config.knobs.emplace_back(type, value);
+  }
+
+  return engine_config;
+}
+
+StatusOr<vm::ref<CuDNNExecutable>> CreateExecutable(
+    openxla_cudnn_dynamic_symbols_t* syms, cudnnHandle_t handle,
+    CuDNNOperationGraph& graph, int64_t workspace_limit) {
+  std::vector<cudnn_frontend::ExecutionPlan> plans;
+  std::vector<CuDNNEngineConfig> engine_configs;
+  std::unordered_set<std::string> tags;
+
+  CuDNNWorkspaceLimitReport report;
+  report.workspace_limit = workspace_limit;
+
+  bool runtime_fusion = iree_all_bits_set(
+      syms->capabilities, OPENXLA_CUDNN_CAPABILITY_RUNTIME_FUSION);
+
+  for (cudnnBackendHeurMode_t mode : kHeuristicsModes) {
+    if (plans.size() >= kMaxExecutionPlans) break;
+
+    // Not all heuristics modes are supported for all operation graphs, and we
+    // simply skip modes that failed to produce engine configs.
+    cudnn_frontend::EngineHeuristics heuristics =
+        cudnn_frontend::EngineHeuristicsBuilder()
+            .setOperationGraph(graph.graph())
+            .setHeurMode(mode)
+            .build();
+    if (heuristics.get_status() != CUDNN_STATUS_SUCCESS) continue;
+
+    auto& configs =
+        heuristics.getEngineConfig(heuristics.getEngineConfigCount());
+
+    for (cudnn_frontend::ManagedOpaqueDescriptor& config : configs) {
+      if (plans.size() >= kMaxExecutionPlans) break;
+
+      if (HasUnsupportedNumericalNotes(config->get_backend_descriptor()))
+        continue;
+
+      // Runtime fusion engines compile kernels for the operation graph and
+      // often are the fastest ones, but we can use them only if the loaded
+      // cuDNN supports them.
+      if (!runtime_fusion &&
+          cudnn_frontend::hasBehaviorNote<
+              CUDNN_BEHAVIOR_NOTE_RUNTIME_COMPILATION>(
+              config->get_backend_descriptor()))
+        continue;
+
+      // Engine config might be not supported for the operation graph, in
+      // this case we skip it and try the next one.
+      cudnn_frontend::ExecutionPlan plan =
+          cudnn_frontend::ExecutionPlanBuilder()
+              .setHandle(handle)
+              .setEngineConfig(config, graph.graph().getTag())
+              .build();
+      if (plan.get_status() != CUDNN_STATUS_SUCCESS) continue;
+
+      // Different heuristics modes can suggest the same engine configs.
+      if (!tags.insert(plan.getTag()).second) continue;
+
+      if (tags.size() == 1)
+        report.preferred_workspace_size = plan.getWorkspaceSize();
+
+      if (plan.getWorkspaceSize() > workspace_limit) {
+        ++report.num_dropped_plans;
+        continue;
+      }
+
+      if (plans.empty()) report.first_plan_rank = tags.size() - 1;
+
+      IREE_ASSIGN_OR_RETURN(
+          CuDNNEngineConfig engine_config,
+          GetEngineConfig(syms, config->get_backend_descriptor()));
+
+      plans.push_back(std::move(plan));
+      engine_configs.push_back(std::move(engine_config));
+    }
+  }
+
+  if (plans.empty() && report.num_dropped_plans > 0)
+    return Status(StatusCode::kResourceExhausted,
+                  "all execution plans for cuDNN operation graph request more "
+                  "workspace than the workspace limit");
+
+  if (plans.empty())
+    return Status(StatusCode::kNotFound,
+                  "no supported execution plans for cuDNN operation graph");
+
+  return vm::ref<CuDNNExecutable>(new CuDNNExecutable(
+      syms, graph, std::move(plans), std::move(engine_configs), report));
+}
+
+StatusOr<vm::ref<CuDNNExecutable>> CreateExecutable(
+    openxla_cudnn_dynamic_symbols_t* syms, cudnnHandle_t handle,
+    CuDNNOperationGraph& graph, span<const CuDNNEngineConfig> engine_configs,
+    int64_t workspace_limit) {
+  std::vector<cudnn_frontend::ExecutionPlan> plans;
+
+  for (const CuDNNEngineConfig& engine_config : engine_configs) {
+    cudnn_frontend::Engine engine =
+        cudnn_frontend::EngineBuilder()
+            .setGlobalEngineIdx(engine_config.engine_id)
+            .setOperationGraph(graph.graph())
+            .build();
+    IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, engine.get_status()));
+
+    // Set knob choices for all knobs supported by the engine.
+    for (auto& knob : engine.getSupportedKnobs()) {
+      for (auto& [type, value] : engine_config.knobs) {
+        if (knob.getKnobType() == type) knob.setChoice(value);
+      }
+    }
+
+    cudnn_frontend::EngineConfig config =
+        cudnn_frontend::EngineConfigBuilder().setEngine(engine).build();
+    IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, config.get_status()));
+
+    cudnn_frontend::ExecutionPlan plan = cudnn_frontend::ExecutionPlanBuilder()
+                                             .setHandle(handle)
+                                             .setEngineConfig(config)
+                                             .build();
+    IREE_RETURN_IF_ERROR(CUDNN_CONVERT_STATUS(syms, plan.get_status()));
+
+    if (plan.getWorkspaceSize() > workspace_limit)
+      return Status(StatusCode::kResourceExhausted,
+                    "execution plan requests more workspace than the "
+                    "workspace limit");
+
+    plans.push_back(std::move(plan));
+  }
+
+  if (plans.empty())
+    return Status(StatusCode::kInvalidArgument,
+                  "engine configs must not be empty");
+
+  CuDNNWorkspaceLimitReport report;
+  report.workspace_limit = workspace_limit;
+  report.preferred_workspace_size = plans.front().getWorkspaceSize();
+
+  return vm::ref<CuDNNExecutable>(new CuDNNExecutable(
+      syms, graph, std::move(plans),
+      {engine_configs.begin(), engine_configs.end()}, report));
 }
 
 }  // namespace openxla::runtime::nvgpu
@@ -213,3 +1163,5 @@ IREE_VM_DEFINE_TYPE_ADAPTERS(cudnn_tensor,
                              openxla::runtime::nvgpu::CuDNNTensor);
 IREE_VM_DEFINE_TYPE_ADAPTERS(cudnn_operation_graph,
                              openxla::runtime::nvgpu::CuDNNOperationGraph);
+IREE_VM_DEFINE_TYPE_ADAPTERS(cudnn_executable,
+                             openxla::runtime::nvgpu::CuDNNExecutable);
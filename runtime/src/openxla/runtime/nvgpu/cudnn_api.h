@@ -12,11 +12,19 @@
 #include <cudnn_frontend.h>
 #include <iree/vm/ref_cc.h>
 
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "iree/base/internal/span.h"
 #include "iree/vm/api.h"
 #include "openxla/runtime/nvgpu/dynamic_symbols.h"
+#include "openxla/runtime/nvgpu/variant_pack_cache.h"
 
 namespace openxla::runtime::nvgpu {
 
@@ -30,17 +38,24 @@ namespace openxla::runtime::nvgpu {
 
 class CuDNNTensor : public iree::vm::RefObject<CuDNNTensor> {
  public:
-  enum class Kind { kArg, kOpResult };
+  enum class Kind { kArg, kScalar, kOpResult };
 
-  explicit CuDNNTensor(Kind kind) : kind_(kind) {}
+  CuDNNTensor(Kind kind, uint64_t fingerprint)
+      : kind_(kind), fingerprint_(fingerprint) {}
   virtual ~CuDNNTensor() = default;
 
   virtual const cudnn_frontend::Tensor& tensor() const = 0;
 
   Kind kind() const { return kind_; }
 
+  // Hash of all tensor properties (dimensions, strides, data type, alignment
+  // and UID) and of all operations (with attributes) computing the tensor.
+  // Tensors with equal fingerprints are computed by identical cuDNN graphs.
+  uint64_t fingerprint() const { return fingerprint_; }
+
  private:
   Kind kind_;
+  uint64_t fingerprint_;
 };
 
 //===----------------------------------------------------------------------===//
@@ -49,9 +64,7 @@ class CuDNNTensor : public iree::vm::RefObject<CuDNNTensor> {
 
 class CuDNNArgTensor final : public CuDNNTensor {
  public:
-  CuDNNArgTensor(openxla_cudnn_dynamic_symbols_t* syms,
-                 cudnn_frontend::Tensor tensor);
-  ~CuDNNArgTensor() override;
+  explicit CuDNNArgTensor(cudnn_frontend::Tensor tensor);
 
   const cudnn_frontend::Tensor& tensor() const override;
 
@@ -60,33 +73,67 @@ class CuDNNArgTensor final : public CuDNNTensor {
   }
 
  private:
-  openxla_cudnn_dynamic_symbols_t* syms_;
   std::optional<cudnn_frontend::Tensor> tensor_;
 };
 
+//===----------------------------------------------------------------------===//
+// By-value scalar tensor passed to cuDNN operations from the host memory.
+//===----------------------------------------------------------------------===//
+
+class CuDNNScalarTensor final : public CuDNNTensor {
+ public:
+  // Scalar value stored in the cuDNN data type of the tensor.
+  union Value {
+    float f32;
+    double f64;
+    int32_t i32;
+    int64_t i64;
+  };
+
+  CuDNNScalarTensor(cudnn_frontend::Tensor tensor, Value value);
+
+  const cudnn_frontend::Tensor& tensor() const override;
+
+  // Host memory bound to the tensor at execution time.
+  void* data() { return &value_; }
+
+  static bool classof(const CuDNNTensor* tensor) {
+    return tensor->kind() == Kind::kScalar;
+  }
+
+ private:
+  std::optional<cudnn_frontend::Tensor> tensor_;
+  alignas(16) Value value_;
+};
+
 //===----------------------------------------------------------------------===//
 // Tensor corresponding to the cuDNN operation result.
 //===----------------------------------------------------------------------===//
 
 class CuDNNOpResultTensor final : public CuDNNTensor {
  public:
-  CuDNNOpResultTensor(openxla_cudnn_dynamic_symbols_t* syms,
-                      iree::span<CuDNNTensor* const> inputs,
+  // Builds a cuDNN operation computing the `result` tensor from the `inputs`
+  // tensors. Operation graph uses it to rebuild the operation when it replaces
+  // input or result tensors with virtual ones.
+  using Builder = std::function<iree::StatusOr<cudnn_frontend::Operation>(
+      iree::span<const cudnn_frontend::Tensor* const> inputs,
+      const cudnn_frontend::Tensor& result)>;
+
+  CuDNNOpResultTensor(iree::span<CuDNNTensor* const> inputs,
                       cudnn_frontend::Operation operation,
-                      cudnn_frontend::Tensor tensor);
-  ~CuDNNOpResultTensor() override;
+                      cudnn_frontend::Tensor tensor, uint64_t fingerprint,
+                      Builder builder);
 
   std::vector<CuDNNTensor*> inputs() const;
   const cudnn_frontend::Operation* operation() const;
   const cudnn_frontend::Tensor& tensor() const override;
+  const Builder& builder() const { return builder_; }
 
   static bool classof(const CuDNNTensor* tensor) {
     return tensor->kind() == Kind::kOpResult;
   }
 
  private:
-  openxla_cudnn_dynamic_symbols_t* syms_;
-
   // Tensors inputs to the cuDNN operation. We need to keep a reference to them
   // to be able to traverse use-def chains when building an operation graph.
   std::vector<iree::vm::ref<CuDNNTensor>> inputs_;
@@ -94,6 +141,8 @@ class CuDNNOpResultTensor final : public CuDNNTensor {
   // cuDNN operation that computes the result tensor.
   std::optional<cudnn_frontend::Operation> operation_;
   std::optional<cudnn_frontend::Tensor> tensor_;
+
+  Builder builder_;
 };
 
 //===----------------------------------------------------------------------===//
@@ -102,37 +151,264 @@ class CuDNNOpResultTensor final : public CuDNNTensor {
 
 class CuDNNOperationGraph : public iree::vm::RefObject<CuDNNOperationGraph> {
  public:
-  CuDNNOperationGraph(openxla_cudnn_dynamic_symbols_t* syms,
-                      cudnn_frontend::OperationGraph graph);
+  CuDNNOperationGraph(cudnn_frontend::OperationGraph graph,
+                      std::vector<iree::vm::ref<CuDNNTensor>> args,
+                      std::vector<iree::vm::ref<CuDNNTensor>> rets,
+                      std::vector<iree::vm::ref<CuDNNTensor>> scalars,
+                      std::deque<cudnn_frontend::Tensor> virtual_tensors,
+                      std::deque<cudnn_frontend::Operation> operations,
+                      uint64_t fingerprint);
   ~CuDNNOperationGraph();
 
+  cudnn_frontend::OperationGraph& graph();
   const cudnn_frontend::OperationGraph& graph() const;
 
+  // Graph arguments sorted by UID.
+  const std::vector<iree::vm::ref<CuDNNTensor>>& args() const;
+
+  // Graph results in the order they were passed to the graph constructor.
+  const std::vector<iree::vm::ref<CuDNNTensor>>& rets() const;
+
+  // UIDs of all non-virtual tensors that must be bound to device memory to
+  // execute the graph: arguments and then results. Intermediate tensors are
+  // always virtual.
+  const std::vector<int64_t>& uids() const;
+
+  // Non-virtual tensors in the same order as `uids()`.
+  const std::vector<const CuDNNTensor*>& tensors() const;
+
+  // UIDs and host memory of by-value scalar tensors, that are bound to the
+  // graph by the executable and never passed by the user.
+  const std::vector<int64_t>& scalar_uids() const { return scalar_uids_; }
+  const std::vector<void*>& scalar_ptrs() const { return scalar_ptrs_; }
+
+  // Canonical hash of the operation graph computed from the fingerprints of
+  // all graph results. Graphs with equal fingerprints can share executables.
+  uint64_t fingerprint() const { return fingerprint_; }
+
  private:
-  openxla_cudnn_dynamic_symbols_t* syms_;
   std::optional<cudnn_frontend::OperationGraph> graph_;
+
+  std::vector<iree::vm::ref<CuDNNTensor>> args_;
+  std::vector<iree::vm::ref<CuDNNTensor>> rets_;
+  std::vector<iree::vm::ref<CuDNNTensor>> scalars_;
+
+  // Virtual tensors replacing intermediate operation results, and operations
+  // rebuilt to use them. Both are owned by the graph, because operation results
+  // can be shared by graphs with different results.
+  std::deque<cudnn_frontend::Tensor> virtual_tensors_;
+  std::deque<cudnn_frontend::Operation> operations_;
+
+  std::vector<int64_t> uids_;
+  std::vector<const CuDNNTensor*> tensors_;
+
+  std::vector<int64_t> scalar_uids_;
+  std::vector<void*> scalar_ptrs_;
+
+  uint64_t fingerprint_;
+};
+
+//===----------------------------------------------------------------------===//
+// CuDNN engine config.
+//===----------------------------------------------------------------------===//
+
+// Engine config uniquely identifies how cuDNN executes an operation graph: the
+// engine global index and tuning knob choices. Engine configs can be persisted
+// and used to re-create execution plans without querying cuDNN heuristics.
+struct CuDNNEngineConfig {
+  int64_t engine_id = 0;
+  std::vector<std::pair<cudnnBackendKnobType_t, int64_t>> knobs;
+};
+
+//===----------------------------------------------------------------------===//
+// CuDNN executable.
+//===----------------------------------------------------------------------===//
+
+// Describes how the workspace limit affected execution plans selection. cuDNN
+// does not report expected plan performance, and the position of the plan in
+// the heuristics order is the best available estimate of what the limit costs.
+struct CuDNNWorkspaceLimitReport {
+  // Maximum workspace size (in bytes) that an execution plan can request.
+  int64_t workspace_limit = 0;
+  // Number of execution plans suggested by heuristics that were dropped
+  // because they requested more workspace than the limit.
+  int64_t num_dropped_plans = 0;
+  // Position of the first execution plan within the limit in the heuristics
+  // order (zero if the limit did not affect plans selection).
+  int64_t first_plan_rank = 0;
+  // Workspace size (in bytes) requested by the plan preferred by heuristics.
+  int64_t preferred_workspace_size = 0;
+};
+
+// CuDNN executable encapsulates all the details of configuring cuDNN engines
+// for executing an operation graph: execution plans for the engine configs
+// suggested by cuDNN heuristics, ordered by their expected performance.
+class CuDNNExecutable : public iree::vm::RefObject<CuDNNExecutable> {
+ public:
+  CuDNNExecutable(openxla_cudnn_dynamic_symbols_t* syms,
+                  CuDNNOperationGraph& graph,
+                  std::vector<cudnn_frontend::ExecutionPlan> plans,
+                  std::vector<CuDNNEngineConfig> engine_configs,
+                  CuDNNWorkspaceLimitReport workspace_limit_report);
+  ~CuDNNExecutable();
+
+  const CuDNNOperationGraph& graph() const;
+
+  // Execution plans ordered by preference. It is guaranteed that executable
+  // has at least one plan, and the first one is used for graph execution.
+  const std::vector<cudnn_frontend::ExecutionPlan>& plans() const;
+
+  // Engine configs corresponding to execution plans.
+  const std::vector<CuDNNEngineConfig>& engine_configs() const;
+
+  // Returns how the workspace limit affected execution plans selection.
+  const CuDNNWorkspaceLimitReport& workspace_limit_report() const;
+
+  // Moves the plan at `index` (and its engine config) to the front, keeping
+  // the relative order of other plans. Must be called before the executable
+  // is shared with other threads (e.g. inserted into the plan cache).
+  void SelectPlan(size_t index);
+
+  // Executes the execution plan at `plan_index` with `buffers` bound to the
+  // graph tensors (see `CuDNNOperationGraph::uids()`), and `workspace` of at
+  // least `plan.getWorkspaceSize()` bytes (can be null if workspace is empty).
+  // Variant packs are cached for recently used buffers, so repeated launches
+  // with the same buffers do not allocate any host memory.
+  iree::Status Execute(cudnnHandle_t handle, size_t plan_index,
+                       iree::span<void* const> buffers, void* workspace) const;
+
+  // Returns an approximate host memory footprint of the executable. cuDNN does
+  // not report the size of backend descriptors (and compiled kernels owned by
+  // them), so we rely on a rough per-plan estimate.
+  size_t ApproximateSizeInBytes() const;
+
+ private:
+  openxla_cudnn_dynamic_symbols_t* syms_;
+  iree::vm::ref<CuDNNOperationGraph> graph_;
+  std::vector<cudnn_frontend::ExecutionPlan> plans_;
+  std::vector<CuDNNEngineConfig> engine_configs_;
+  CuDNNWorkspaceLimitReport workspace_limit_report_;
+
+  // Executable can be shared by multiple module states running concurrently
+  // on different threads, and launches must be synchronized to access cached
+  // variant packs.
+  mutable std::mutex mu_;
+  mutable VariantPackCache<cudnn_frontend::VariantPack> variant_packs_;
 };
 
 //===----------------------------------------------------------------------===//
 // Wrappers around cuDNN APIs export from a cuDNN module to the user.
 //===----------------------------------------------------------------------===//
 
+// Returns the size of the device memory required for storing the tensor.
+iree::StatusOr<size_t> GetTensorSizeInBytes(const CuDNNTensor& tensor);
+
 // Creates a tensor placeholder for cuDNN graph argument.
 iree::StatusOr<iree::vm::ref<CuDNNTensor>> CreateArgument(
     openxla_cudnn_dynamic_symbols_t* syms, iree::span<const int64_t> dims,
     iree::span<const int64_t> strides, int64_t uid, cudnnDataType_t dtype,
     int64_t alignment);
 
+// Creates a by-value scalar tensor of the given rank (all dimensions are 1)
+// that can be used as an input of pointwise operations (e.g. scale or bias).
+iree::StatusOr<iree::vm::ref<CuDNNTensor>> CreateScalar(
+    openxla_cudnn_dynamic_symbols_t* syms, cudnnDataType_t dtype, double value,
+    int64_t rank, int64_t uid);
+
+// Attributes of pointwise operations that are not defined by the mode (ignored
+// by the modes that do not use them).
+struct CuDNNPointwiseAttrs {
+  double lower_clip = 0.0;
+  double upper_clip = std::numeric_limits<double>::infinity();
+  // Slope of the relu below the lower clip (leaky relu).
+  double lower_clip_slope = 0.0;
+  double elu_alpha = 1.0;
+  double softplus_beta = 1.0;
+  double swish_beta = 1.0;
+};
+
+// Creates a pointwise operation with one (unary), two (binary) or three inputs
+// (`select` of the first two inputs with the third one as a predicate). All
+// inputs must have the same rank, and unit dimensions are broadcasted to the
+// result shape. Result is laid out as the first input with the result shape
+// (row major if all inputs are broadcasted), and compare and logical modes
+// produce boolean results.
+iree::StatusOr<iree::vm::ref<CuDNNTensor>> CreatePointwise(
+    openxla_cudnn_dynamic_symbols_t* syms, cudnnPointwiseMode_t mode,
+    iree::span<CuDNNTensor* const> inputs, int64_t uid, int64_t alignment,
+    const CuDNNPointwiseAttrs& attrs = {});
+
+// Creates a pointwise add operation.
+iree::StatusOr<iree::vm::ref<CuDNNTensor>> CreatePointwiseAdd(
+    openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& lhs, CuDNNTensor& rhs,
+    int64_t uid, int64_t alignment);
+
 // Creates a pointwise relu operation.
 iree::StatusOr<iree::vm::ref<CuDNNTensor>> CreatePointwiseRelu(
     openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& input,
     double lower_clip, double upper_clip, int64_t uid, int64_t alignment);
 
-// Creates an operation graph computing tensor results.
+// Creates a pointwise GELU operation (tanh approximation).
+iree::StatusOr<iree::vm::ref<CuDNNTensor>> CreatePointwiseGelu(
+    openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& input, int64_t uid,
+    int64_t alignment);
+
+// Creates a matrix multiplication operation of `a` [batch, m, k] and `b`
+// [batch, k, n] tensors. The batch dimension of `b` can be 1 (broadcasted to
+// all batches of `a`). The result [batch, m, n] tensor is row major.
+iree::StatusOr<iree::vm::ref<CuDNNTensor>> CreateMatmul(
+    openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& a, CuDNNTensor& b,
+    int64_t uid, int64_t alignment);
+
+// Attributes of the convolution forward operation. Spatial attributes must have
+// one value for each spatial dimension of the input tensor.
+struct CuDNNConvolutionAttrs {
+  cudnnConvolutionMode_t mode = CUDNN_CROSS_CORRELATION;
+  std::vector<int64_t> strides;
+  std::vector<int64_t> pre_padding;
+  std::vector<int64_t> post_padding;
+  std::vector<int64_t> dilations;
+  // Result is computed as `alpha * conv(x, w) + beta * y`.
+  double alpha = 1.0;
+  double beta = 0.0;
+};
+
+// Creates a 2D or 3D convolution forward operation with `x` input in
+// [N, C, (D,) H, W] and `w` filter in [K, C / groups, (D,) H, W] logical
+// layouts. Number of groups is inferred from the input and filter channels.
+// Result has the same physical layout as the input. Virtual results are not
+// bound to device memory and can only be consumed by other operations in the
+// same graph (e.g. a pointwise epilogue).
+iree::StatusOr<iree::vm::ref<CuDNNTensor>> CreateConvolution(
+    openxla_cudnn_dynamic_symbols_t* syms, CuDNNTensor& x, CuDNNTensor& w,
+    const CuDNNConvolutionAttrs& attrs, int64_t uid, int64_t alignment,
+    bool is_virtual = false);
+
+// Creates an operation graph computing tensor results. Results must not be
+// virtual tensors. Operation results that are not graph results are replaced
+// with virtual tensors with automatically assigned UIDs, so that cuDNN can keep
+// fused intermediates in on-chip memory instead of writing them to HBM.
 iree::StatusOr<iree::vm::ref<CuDNNOperationGraph>> CreateOperationGraph(
     openxla_cudnn_dynamic_symbols_t* syms, cudnnHandle_t handle,
     iree::span<CuDNNTensor* const> results);
 
+// Creates an executable for an operation graph by building execution plans for
+// the engine configs suggested by cuDNN heuristics. Execution plans requesting
+// more than `workspace_limit` bytes of workspace are dropped.
+iree::StatusOr<iree::vm::ref<CuDNNExecutable>> CreateExecutable(
+    openxla_cudnn_dynamic_symbols_t* syms, cudnnHandle_t handle,
+    CuDNNOperationGraph& graph, int64_t workspace_limit);
+
+// Creates an executable for an operation graph by building execution plans for
+// the given engine configs (e.g. loaded from the plan database). Returns an
+// error if any of the plans requests more than `workspace_limit` bytes of
+// workspace.
+iree::StatusOr<iree::vm::ref<CuDNNExecutable>> CreateExecutable(
+    openxla_cudnn_dynamic_symbols_t* syms, cudnnHandle_t handle,
+    CuDNNOperationGraph& graph,
+    iree::span<const CuDNNEngineConfig> engine_configs,
+    int64_t workspace_limit);
+
 }  // namespace openxla::runtime::nvgpu
 
 //===----------------------------------------------------------------------===//
@@ -143,5 +419,7 @@ IREE_VM_DECLARE_TYPE_ADAPTERS(cudnn_tensor,
                               openxla::runtime::nvgpu::CuDNNTensor);
 IREE_VM_DECLARE_TYPE_ADAPTERS(cudnn_operation_graph,
                               openxla::runtime::nvgpu::CuDNNOperationGraph);
+IREE_VM_DECLARE_TYPE_ADAPTERS(cudnn_executable,
+                              openxla::runtime::nvgpu::CuDNNExecutable);
 
 #endif  // OPENXLA_RUNTIME_NVGPU_CUDNN_API_H_
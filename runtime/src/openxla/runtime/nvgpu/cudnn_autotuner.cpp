@@ -0,0 +1,169 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/cudnn_autotuner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "iree/hal/drivers/cuda/status_util.h"
+#include "openxla/runtime/nvgpu/status_util.h"
+
+namespace openxla::runtime::nvgpu {
+
+using namespace iree;
+
+namespace {
+
+// Scratch device memory and CUDA events used for timing execution plans. All
+// resources are released when the timer is destroyed.
+class CuDNNPlanTimer final : public AutotuneTimer {
+ public:
+  CuDNNPlanTimer(iree_hal_cuda_dynamic_symbols_t* cuda_syms,
+                 cudnnHandle_t handle, CUstream stream,
+                 const CuDNNExecutable& executable)
+      : cuda_syms_(cuda_syms),
+        handle_(handle),
+        stream_(stream),
+        executable_(executable) {}
+
+  ~CuDNNPlanTimer() override {
+    for (CUdeviceptr buffer : buffers_) Free(buffer);
+    Free(workspace_);
+    for (CUevent event : {start_, stop_}) {
+      if (!event) continue;
+      iree_status_ignore(CU_RESULT_TO_STATUS(cuda_syms_, cuEventDestroy(event),
+                                             "cuEventDestroy"));
+    }
+  }
+
+  // Allocates zero-initialized buffers for all graph tensors and a workspace
+  // large enough for the first `num_candidates` execution plans.
+  Status Initialize(size_t num_candidates) {
+    for (const CuDNNTensor* tensor : executable_.graph().tensors()) {
+      IREE_ASSIGN_OR_RETURN(size_t size, GetTensorSizeInBytes(*tensor));
+      IREE_ASSIGN_OR_RETURN(CUdeviceptr buffer, Allocate(size));
+      buffers_.push_back(buffer);
+    }
+
+    for (size_t i = 0; i < num_candidates; ++i) {
+      workspace_size_ = std::max(
+          workspace_size_, executable_.plans()[i].getWorkspaceSize());
+    }
+    IREE_ASSIGN_OR_RETURN(workspace_, Allocate(workspace_size_));
+
+    CUDA_RETURN_IF_ERROR(cuda_syms_,
+                         cuEventCreate(&start_, CU_EVENT_DEFAULT),
+                         "cuEventCreate");
+    CUDA_RETURN_IF_ERROR(cuda_syms_, cuEventCreate(&stop_, CU_EVENT_DEFAULT),
+                         "cuEventCreate");
+    return OkStatus();
+  }
+
+  StatusOr<float> Measure(size_t candidate, int64_t warmup_iterations,
+                          int64_t iterations) override {
+    std::vector<void*> buffers;
+    for (CUdeviceptr buffer : buffers_)
+      buffers.push_back(reinterpret_cast<void*>(buffer));
+    void* workspace = reinterpret_cast<void*>(workspace_);
+
+    for (int64_t i = 0; i < warmup_iterations; ++i) {
+      IREE_RETURN_IF_ERROR(
+          executable_.Execute(handle_, candidate, buffers, workspace));
+    }
+
+    CUDA_RETURN_IF_ERROR(cuda_syms_, cuEventRecord(start_, stream_),
+                         "cuEventRecord");
+    for (int64_t i = 0; i < iterations; ++i) {
+      IREE_RETURN_IF_ERROR(
+          executable_.Execute(handle_, candidate, buffers, workspace));
+    }
+    CUDA_RETURN_IF_ERROR(cuda_syms_, cuEventRecord(stop_, stream_),
+                         "cuEventRecord");
+    CUDA_RETURN_IF_ERROR(cuda_syms_, cuEventSynchronize(stop_),
+                         "cuEventSynchronize");
+
+    float elapsed_ms = 0.0f;
+    CUDA_RETURN_IF_ERROR(cuda_syms_,
+                         cuEventElapsedTime(&elapsed_ms, start_, stop_),
+                         "cuEventElapsedTime");
+    return elapsed_ms / iterations;
+  }
+
+ private:
+  StatusOr<CUdeviceptr> Allocate(size_t size) {
+    CUdeviceptr ptr = 0;
+    if (size == 0) return ptr;
+    CUDA_RETURN_IF_ERROR(cuda_syms_, cuMemAlloc(&ptr, size), "cuMemAlloc");
+    CUDA_RETURN_IF_ERROR(cuda_syms_, cuMemsetD8Async(ptr, 0, size, stream_),
+                         "cuMemsetD8Async");
+    return ptr;
+  }
+
+  void Free(CUdeviceptr ptr) {
+    if (!ptr) return;
+    iree_status_ignore(
+        CU_RESULT_TO_STATUS(cuda_syms_, cuMemFree(ptr), "cuMemFree"));
+  }
+
+  iree_hal_cuda_dynamic_symbols_t* cuda_syms_;
+  cudnnHandle_t handle_;
+  CUstream stream_;
+  const CuDNNExecutable& executable_;
+
+  std::vector<CUdeviceptr> buffers_;
+  CUdeviceptr workspace_ = 0;
+  int64_t workspace_size_ = 0;
+
+  CUevent start_ = nullptr;
+  CUevent stop_ = nullptr;
+};
+
+}  // namespace
+
+static StatusOr<AutotuneResult> AutotuneInContext(
+    openxla_cudnn_dynamic_symbols_t* syms,
+    iree_hal_cuda_dynamic_symbols_t* cuda_syms, cudnnHandle_t handle,
+    CuDNNExecutable& executable, const AutotuneOptions& options) {
+  if (!iree_all_bits_set(syms->capabilities,
+                         OPENXLA_CUDNN_CAPABILITY_AUTOTUNING))
+    return Status(StatusCode::kUnavailable,
+                  "cuDNN library does not support autotuning");
+
+  cudaStream_t stream;
+  CUDNN_RETURN_IF_ERROR(syms, cudnnGetStream(handle, &stream),
+                        "cudnnGetStream");
+
+  size_t num_candidates = std::min(
+      executable.plans().size(),
+      static_cast<size_t>(std::max<int64_t>(options.max_candidates, 0)));
+
+  CuDNNPlanTimer timer(cuda_syms, handle, stream, executable);
+  IREE_RETURN_IF_ERROR(timer.Initialize(num_candidates));
+
+  IREE_ASSIGN_OR_RETURN(
+      AutotuneResult result,
+      Autotune(executable.plans().size(), options, timer));
+  executable.SelectPlan(result.selected);
+  return result;
+}
+
+StatusOr<AutotuneResult> AutotuneExecutable(
+    openxla_cudnn_dynamic_symbols_t* syms,
+    iree_hal_cuda_dynamic_symbols_t* cuda_syms, CUcontext cuda_ctx,
+    cudnnHandle_t handle, CuDNNExecutable& executable,
+    const AutotuneOptions& options) {
+  CUDA_RETURN_IF_ERROR(cuda_syms, cuCtxPushCurrent(cuda_ctx),
+                       "cuCtxPushCurrent");
+  StatusOr<AutotuneResult> result =
+      AutotuneInContext(syms, cuda_syms, handle, executable, options);
+  CUcontext popped;
+  CUDA_RETURN_IF_ERROR(cuda_syms, cuCtxPopCurrent(&popped), "cuCtxPopCurrent");
+  return result;
+}
+
+}  // namespace openxla::runtime::nvgpu
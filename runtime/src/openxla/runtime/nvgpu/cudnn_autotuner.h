@@ -0,0 +1,29 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef OPENXLA_RUNTIME_NVGPU_CUDNN_AUTOTUNER_H_
+#define OPENXLA_RUNTIME_NVGPU_CUDNN_AUTOTUNER_H_
+
+#include "iree/base/status_cc.h"
+#include "iree/hal/drivers/cuda/dynamic_symbols.h"
+#include "openxla/runtime/nvgpu/autotuner.h"
+#include "openxla/runtime/nvgpu/cudnn_api.h"
+#include "openxla/runtime/nvgpu/dynamic_symbols.h"
+
+namespace openxla::runtime::nvgpu {
+
+// Autotunes cuDNN executable: runs execution plans on scratch device buffers
+// on the stream bound to the cuDNN `handle`, times them with CUDA events, and
+// moves the fastest plan to the front (see `CuDNNExecutable::SelectPlan`).
+iree::StatusOr<AutotuneResult> AutotuneExecutable(
+    openxla_cudnn_dynamic_symbols_t* syms,
+    iree_hal_cuda_dynamic_symbols_t* cuda_syms, CUcontext cuda_ctx,
+    cudnnHandle_t handle, CuDNNExecutable& executable,
+    const AutotuneOptions& options);
+
+}  // namespace openxla::runtime::nvgpu
+
+#endif  // OPENXLA_RUNTIME_NVGPU_CUDNN_AUTOTUNER_H_
@@ -12,15 +12,35 @@
 #include <iree/vm/ref_cc.h>
 #include <openxla/runtime/nvgpu/cudnn_api.h>
 
+#include <algorithm>
+#include <cinttypes>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
 
+#include "iree/base/internal/dynamic_library.h"
+#include "iree/base/target_platform.h"
+#include "iree/hal/drivers/cuda/cuda_buffer.h"
 #include "iree/hal/drivers/cuda/cuda_device.h"
+#include "iree/hal/drivers/cuda/dynamic_symbols.h"
+#include "iree/hal/drivers/cuda/status_util.h"
 #include "iree/modules/hal/types.h"
 #include "iree/vm/native_module_cc.h"
+#include "openxla/runtime/nvgpu/autotuner.h"
+#include "openxla/runtime/nvgpu/cudnn_autotuner.h"
+#include "openxla/runtime/nvgpu/cudnn_stub.h"
 #include "openxla/runtime/nvgpu/dynamic_symbols.h"
+#include "openxla/runtime/nvgpu/handle_pool.h"
+#include "openxla/runtime/nvgpu/plan_cache.h"
+#include "openxla/runtime/nvgpu/plan_database.h"
+#include "openxla/runtime/nvgpu/small_vector.h"
 #include "openxla/runtime/nvgpu/status_util.h"
+#include "openxla/runtime/nvgpu/workspace_arena.h"
 
 namespace openxla::runtime::nvgpu {
 
@@ -31,9 +51,115 @@ using namespace iree;
 // operations (launching cuDNN graphs on a stream) at run time.
 //===----------------------------------------------------------------------===//
 
+// Cached cuDNN executable with the full key it was compiled for. Plan cache is
+// keyed by a hash of the graph fingerprint and the workspace limit, and the
+// full key is compared on lookup, so that a hash collision is a cache miss
+// instead of an executable launched on the wrong tensors.
+struct CuDNNPlanCacheEntry {
+  uint64_t fingerprint;
+  int64_t workspace_limit;
+  std::vector<int64_t> signature;
+  vm::ref<CuDNNExecutable> executable;
+};
+
+// Cache of cuDNN executables shared by all module states.
+using CuDNNPlanCache = PlanCache<CuDNNPlanCacheEntry>;
+
+static const char* kCudaLoaderSearchNames[] = {
+#if defined(IREE_PLATFORM_WINDOWS)
+    "nvcuda.dll",
+#else
+    "libcuda.so.1",
+    "libcuda.so",
+#endif  // IREE_PLATFORM_WINDOWS
+};
+
+// CUDA driver stream-ordered memory allocator API (CUDA 11.2+). It is not a
+// part of the IREE CUDA HAL symbol table, so the module resolves it from the
+// CUDA driver library directly.
+struct CudaStreamOrderedSymbols {
+  CUresult (*cuMemAllocAsync)(CUdeviceptr*, size_t, CUstream);
+  CUresult (*cuMemFreeAsync)(CUdeviceptr, CUstream);
+};
+
+// Returns stream-ordered allocator symbols resolved once per process. The
+// library handle is intentionally leaked, as the CUDA driver stays loaded for
+// the lifetime of the process anyway.
+static StatusOr<const CudaStreamOrderedSymbols*> GetStreamOrderedSymbols() {
+  static const CudaStreamOrderedSymbols* resolved =
+      []() -> const CudaStreamOrderedSymbols* {
+    iree_dynamic_library_t* library = nullptr;
+    iree_status_t status = iree_dynamic_library_load_from_files(
+        IREE_ARRAYSIZE(kCudaLoaderSearchNames), kCudaLoaderSearchNames,
+        IREE_DYNAMIC_LIBRARY_FLAG_NONE, iree_allocator_system(), &library);
+
+    auto syms = std::make_unique<CudaStreamOrderedSymbols>();
+    if (iree_status_is_ok(status)) {
+      status = iree_dynamic_library_lookup_symbol(
+          library, "cuMemAllocAsync", (void**)&syms->cuMemAllocAsync);
+    }
+    if (iree_status_is_ok(status)) {
+      status = iree_dynamic_library_lookup_symbol(
+          library, "cuMemFreeAsync", (void**)&syms->cuMemFreeAsync);
+    }
+
+    if (!iree_status_is_ok(status)) {
+      iree_status_ignore(status);
+      iree_dynamic_library_release(library);
+      return nullptr;
+    }
+    return syms.release();
+  }();
+
+  if (!resolved)
+    return Status(StatusCode::kUnavailable,
+                  "CUDA stream-ordered memory allocator is not available "
+                  "(requires CUDA driver 11.2 or newer)");
+  return resolved;
+}
+
+// Workspace allocator using CUDA stream-ordered memory allocator, so that
+// growing the workspace arena does not synchronize with the device.
+class CudaWorkspaceAllocator final : public WorkspaceAllocator {
+ public:
+  explicit CudaWorkspaceAllocator(CUstream stream) : stream_(stream) {}
+
+  StatusOr<void*> Allocate(size_t size) override {
+    IREE_ASSIGN_OR_RETURN(const CudaStreamOrderedSymbols* syms,
+                          GetStreamOrderedSymbols());
+    CUdeviceptr ptr = 0;
+    CUresult result = syms->cuMemAllocAsync(&ptr, size, stream_);
+    if (result != CUDA_SUCCESS)
+      return Status(iree_make_status(IREE_STATUS_RESOURCE_EXHAUSTED,
+                                     "cuMemAllocAsync failed with CUresult %d",
+                                     static_cast<int>(result)));
+    return reinterpret_cast<void*>(ptr);
+  }
+
+  Status Free(void* ptr) override {
+    IREE_ASSIGN_OR_RETURN(const CudaStreamOrderedSymbols* syms,
+                          GetStreamOrderedSymbols());
+    CUresult result =
+        syms->cuMemFreeAsync(reinterpret_cast<CUdeviceptr>(ptr), stream_);
+    if (result != CUDA_SUCCESS)
+      return Status(iree_make_status(IREE_STATUS_INTERNAL,
+                                     "cuMemFreeAsync failed with CUresult %d",
+                                     static_cast<int>(result)));
+    return OkStatus();
+  }
+
+ private:
+  CUstream stream_;
+};
+
 class CuDNNModuleState {
  public:
-  CuDNNModuleState(openxla_cudnn_dynamic_symbols_t syms, cudnnHandle_t handle);
+  CuDNNModuleState(openxla_cudnn_dynamic_symbols_t* syms,
+                   iree_hal_cuda_dynamic_symbols_t* cuda_syms,
+                   CUcontext cuda_ctx, CUstream cuda_stream,
+                   HandlePool::Handle handle, CuDNNPlanCache* plan_cache,
+                   PlanDatabase* plan_database, int64_t compute_capability,
+                   int64_t workspace_limit, AutotuneOptions autotune_options);
   ~CuDNNModuleState();
 
   // Creates a new tensor for cuDNN graph argument.
@@ -41,44 +167,243 @@ class CuDNNModuleState {
                                           const vm::ref<iree_vm_list_t> dims,
                                           int64_t uid, int64_t alignment);
 
+  // Creates a new tensor for cuDNN graph argument with explicit strides (e.g.
+  // for tensors in NHWC layout).
+  StatusOr<vm::ref<CuDNNTensor>> StridedArgument(
+      int64_t dtype, const vm::ref<iree_vm_list_t> dims,
+      const vm::ref<iree_vm_list_t> strides, int64_t uid, int64_t alignment);
+
+  // Creates a by-value scalar tensor of the given rank.
+  StatusOr<vm::ref<CuDNNTensor>> Scalar(int64_t dtype, float value,
+                                        int64_t rank, int64_t uid);
+
+  // Creates a pointwise operation of the given `cudnnPointwiseMode_t` mode with
+  // one, two or three (select) inputs and returns result tensor. Unary modes
+  // take clipping (relu) and `alpha` attributes, where `alpha` is the relu
+  // slope below the lower clip, ELU alpha, or softplus and swish beta.
+  StatusOr<vm::ref<CuDNNTensor>> PointwiseUnary(
+      int64_t mode, const vm::ref<CuDNNTensor> x, float lower_clip,
+      float upper_clip, float alpha, int64_t uid, int64_t alignment);
+  StatusOr<vm::ref<CuDNNTensor>> PointwiseBinary(
+      int64_t mode, const vm::ref<CuDNNTensor> x, const vm::ref<CuDNNTensor> b,
+      int64_t uid, int64_t alignment);
+  StatusOr<vm::ref<CuDNNTensor>> PointwiseTernary(
+      int64_t mode, const vm::ref<CuDNNTensor> x, const vm::ref<CuDNNTensor> b,
+      const vm::ref<CuDNNTensor> t, int64_t uid, int64_t alignment);
+
+  // Creates a pointwise add operation and returns result tensor.
+  StatusOr<vm::ref<CuDNNTensor>> PointwiseAdd(const vm::ref<CuDNNTensor> lhs,
+                                              const vm::ref<CuDNNTensor> rhs,
+                                              int64_t uid, int64_t alignment);
+
   // Creates a pointwise relu operation and returns result tensor.
   StatusOr<vm::ref<CuDNNTensor>> PointwiseRelu(const vm::ref<CuDNNTensor> input,
                                                float lower_clip,
                                                float upper_clip, int64_t uid,
                                                int64_t alignment);
 
-  // TODO(ezhulenev): To be able to pass a list of tensors, `!cudnn.tensor` has
-  // to be registered as a ref type (see `IREE::VM::RefType` and`!vmvx.buffer`
-  // which is registered as reference type and can be added to the list).
+  // Creates a pointwise GELU (tanh approximation) operation and returns result
+  // tensor.
+  StatusOr<vm::ref<CuDNNTensor>> PointwiseGelu(const vm::ref<CuDNNTensor> input,
+                                               int64_t uid, int64_t alignment);
+
+  // Creates a matmul operation and returns result tensor.
+  StatusOr<vm::ref<CuDNNTensor>> Matmul(const vm::ref<CuDNNTensor> a,
+                                        const vm::ref<CuDNNTensor> b,
+                                        int64_t uid, int64_t alignment);
+
+  // Creates a convolution forward operation of the given
+  // `cudnnConvolutionMode_t` mode and returns result tensor.
+  StatusOr<vm::ref<CuDNNTensor>> Convolution(
+      const vm::ref<CuDNNTensor> x, const vm::ref<CuDNNTensor> w, int64_t mode,
+      float alpha, float beta, const vm::ref<iree_vm_list_t> strides,
+      const vm::ref<iree_vm_list_t> pre_padding,
+      const vm::ref<iree_vm_list_t> post_padding,
+      const vm::ref<iree_vm_list_t> dilations, int64_t uid, int64_t alignment,
+      int32_t is_virtual);
 
   // Creates a cuDNN graph computing `tensor` result.
   StatusOr<vm::ref<CuDNNOperationGraph>> CreateGraph(
       const vm::ref<CuDNNTensor> tensor);
 
+  // Creates a cuDNN graph computing all `tensors` results. Operations shared
+  // by multiple results are added to the graph only once, so multi-output
+  // graphs compile into a single execution plan.
+  StatusOr<vm::ref<CuDNNOperationGraph>> CreateGraphFromList(
+      const vm::ref<iree_vm_list_t> tensors);
+
+  // Compiles a cuDNN graph into an executable. Returns a cached executable if
+  // an identical graph was already compiled by any of the module states, and
+  // re-uses engine config recorded in the plan database if available. If
+  // autotuning is enabled, times execution plans suggested by heuristics on
+  // the device and selects the fastest one. Selected plan workspace does not
+  // exceed `workspace_limit` (negative value means the module-wide limit).
+  StatusOr<vm::ref<CuDNNExecutable>> CompileGraph(
+      const vm::ref<CuDNNOperationGraph> graph, int64_t workspace_limit);
+
+  // Returns an executable memoized for the graph `key` (assigned by the
+  // compiler) and concrete values of the graph dynamic dimensions. The first
+  // result is zero if an executable was not memoized yet.
+  StatusOr<std::tuple<int32_t, vm::ref<CuDNNExecutable>>> LookupExecutable(
+      int64_t key, const vm::ref<iree_vm_list_t> shape);
+
+  // Memoizes an executable compiled for the graph `key` and concrete values of
+  // the graph dynamic dimensions.
+  Status MemoizeExecutable(int64_t key, const vm::ref<iree_vm_list_t> shape,
+                           const vm::ref<CuDNNExecutable> executable);
+
+  // Executes a cuDNN executable with buffers bound to the graph tensors (see
+  // `CuDNNOperationGraph::uids()`). Execution is synchronous: buffers must be
+  // ready when the call starts (exported tensors are), and results are written
+  // when the call returns. CUDA HAL does not expose its stream or a way to
+  // record custom commands into a command buffer, so the launch can't be
+  // ordered with the HAL device queue.
+  Status Execute(const vm::ref<CuDNNExecutable> executable,
+                 const vm::ref<iree_vm_list_t> buffers);
+
   // Prints tensor debug information to stderr.
   Status PrintTensorDebug(const vm::ref<CuDNNTensor> tensor);
 
   // Prints graph debug information to stderr.
   Status PrintGraphDebug(const vm::ref<CuDNNOperationGraph> graph);
 
+  // Prints executable debug information to stderr.
+  Status PrintExecutableDebug(const vm::ref<CuDNNExecutable> executable);
+
+  // Prints plan cache statistics to stderr.
+  Status PrintPlanCacheDebug();
+
+  // Prints workspace arena statistics to stderr.
+  Status PrintWorkspaceArenaDebug();
+
  private:
   CuDNNModuleState(const CuDNNModuleState&) = delete;
   CuDNNModuleState& operator=(const CuDNNModuleState&) = delete;
 
-  openxla_cudnn_dynamic_symbols_t syms_;
+  // cuDNN symbols owned by the module and shared by all module states.
+  openxla_cudnn_dynamic_symbols_t* syms_;
+
+  // CUDA symbols and context used for autotuning.
+  iree_hal_cuda_dynamic_symbols_t* cuda_syms_;
+  CUcontext cuda_ctx_;
+
+  // CUDA stream owned by the module. cuDNN executables are launched on it, and
+  // every launch synchronizes the stream with the host before returning,
+  // because the stream is not ordered with the HAL device queue.
+  CUstream cuda_stream_;
 
   // IREE custom module state must be thread-compatible, and access to the same
   // state object will be synchronized by the caller, so we can safely access
-  // cuDNN handle without any additional synchronization.
-  cudnnHandle_t handle_;
+  // cuDNN handle without any additional synchronization. Handle is borrowed
+  // from the module handle pool and returned to it with the state. The pool
+  // lends only handles bound to the module stream, so the stream never has to
+  // be set again.
+  HandlePool::Handle handle_;
+
+  // Plan cache owned by the module. Plan cache is thread-safe and can be
+  // accessed concurrently from multiple module states.
+  CuDNNPlanCache* plan_cache_;
+
+  // Plan database owned by the module (can be null). Plan database is
+  // thread-safe and can be accessed concurrently from multiple module states.
+  PlanDatabase* plan_database_;
+
+  // Compute capability of the CUDA device (e.g. 80 for sm_80).
+  int64_t compute_capability_;
+
+  // Maximum workspace size (in bytes) of execution plans selected for graphs.
+  int64_t workspace_limit_;
+
+  AutotuneOptions autotune_options_;
+
+  // Workspace for all executables launched by this state is sub-allocated
+  // from the arena. Arena is reset before every launch, because the previous
+  // launch was already waited for on the host.
+  CudaWorkspaceAllocator workspace_allocator_;
+  std::unique_ptr<WorkspaceArena> workspace_arena_;
+
+  // Executables compiled for graphs with dynamic shapes, memoized by the graph
+  // key and concrete dynamic dimensions, so that cuDNN descriptors are built
+  // only once for every shape seen at run time. Cache key is a hash of the
+  // graph key and dimensions, and the dimensions are kept with the executable
+  // to detect hash collisions.
+  struct MemoizedExecutable {
+    int64_t key;
+    std::vector<int64_t> shape;
+    vm::ref<CuDNNExecutable> executable;
+  };
+
+  PlanCache<MemoizedExecutable> memoized_executables_;
 };
 
-CuDNNModuleState::CuDNNModuleState(openxla_cudnn_dynamic_symbols_t syms,
-                                   cudnnHandle_t handle)
-    : syms_(syms), handle_(handle) {}
+// Maximum number of memoized executables per module state. Least recently
+// used executables are evicted when the limit is reached, and recompiling them
+// is cheap because compiled plans are kept in the plan cache.
+static constexpr size_t kMaxMemoizedExecutables = 1024;
+
+CuDNNModuleState::CuDNNModuleState(openxla_cudnn_dynamic_symbols_t* syms,
+                                   iree_hal_cuda_dynamic_symbols_t* cuda_syms,
+                                   CUcontext cuda_ctx, CUstream cuda_stream,
+                                   HandlePool::Handle handle,
+                                   CuDNNPlanCache* plan_cache,
+                                   PlanDatabase* plan_database,
+                                   int64_t compute_capability,
+                                   int64_t workspace_limit,
+                                   AutotuneOptions autotune_options)
+    : syms_(syms),
+      cuda_syms_(cuda_syms),
+      cuda_ctx_(cuda_ctx),
+      cuda_stream_(cuda_stream),
+      handle_(std::move(handle)),
+      plan_cache_(plan_cache),
+      plan_database_(plan_database),
+      compute_capability_(compute_capability),
+      workspace_limit_(workspace_limit),
+      autotune_options_(autotune_options),
+      workspace_allocator_(cuda_stream),
+      workspace_arena_(std::make_unique<WorkspaceArena>(&workspace_allocator_)),
+      // Memoized executables are sized in entries, not bytes.
+      memoized_executables_(kMaxMemoizedExecutables) {}
 
 CuDNNModuleState::~CuDNNModuleState() {
-  CUDNN_STATUS_CHECK_OK(&syms_, cudnnDestroy(handle_));
+  // Workspace memory is released with a stream-ordered free that requires
+  // CUDA context to be current.
+  CUcontext popped;
+  IREE_CHECK_OK(CU_RESULT_TO_STATUS(cuda_syms_, cuCtxPushCurrent(cuda_ctx_),
+                                    "cuCtxPushCurrent"));
+  workspace_arena_.reset();
+  IREE_CHECK_OK(CU_RESULT_TO_STATUS(cuda_syms_, cuCtxPopCurrent(&popped),
+                                    "cuCtxPopCurrent"));
+}
+
+// Returns a structural signature of the graph: UIDs, data types, alignments,
+// dimensions and strides of all tensors bound to the graph, and UIDs of
+// by-value scalars. Graphs with different signatures can't share executables.
+static std::vector<int64_t> GraphSignature(const CuDNNOperationGraph& graph) {
+  std::vector<int64_t> signature;
+  for (const CuDNNTensor* tensor : graph.tensors()) {
+    const cudnn_frontend::Tensor& desc = tensor->tensor();
+    int64_t rank = desc.getDimensionCount();
+    signature.push_back(desc.getId());
+    signature.push_back(static_cast<int64_t>(desc.getDataType()));
+    signature.push_back(desc.getAlignment());
+    signature.push_back(rank);
+    signature.insert(signature.end(), desc.getDimArray(),
+                     desc.getDimArray() + rank);
+    signature.insert(signature.end(), desc.getStrideArray(),
+                     desc.getStrideArray() + rank);
+  }
+  const std::vector<int64_t>& scalar_uids = graph.scalar_uids();
+  signature.insert(signature.end(), scalar_uids.begin(), scalar_uids.end());
+  return signature;
+}
+
+// Returns a plan cache key for a graph compiled with the workspace limit.
+static uint64_t PlanCacheKey(uint64_t fingerprint, int64_t workspace_limit) {
+  uint64_t limit = static_cast<uint64_t>(workspace_limit);
+  return fingerprint ^
+         (limit + 0x9e3779b97f4a7c15ull + (fingerprint << 6) +
+          (fingerprint >> 2));
 }
 
 static StatusOr<cudnnDataType_t> ToCudnnDataType(int64_t dtype) {
@@ -87,6 +412,71 @@ static StatusOr<cudnnDataType_t> ToCudnnDataType(int64_t dtype) {
   return static_cast<cudnnDataType_t>(dtype);
 }
 
+// Returns pointwise mode if it is a forward mode with `num_inputs` inputs.
+static StatusOr<cudnnPointwiseMode_t> ToCudnnPointwiseMode(int64_t mode,
+                                                           size_t num_inputs) {
+  size_t expected_inputs = 0;
+  switch (mode) {
+    case CUDNN_POINTWISE_ABS:
+    case CUDNN_POINTWISE_CEIL:
+    case CUDNN_POINTWISE_COS:
+    case CUDNN_POINTWISE_EXP:
+    case CUDNN_POINTWISE_FLOOR:
+    case CUDNN_POINTWISE_LOG:
+    case CUDNN_POINTWISE_NEG:
+    case CUDNN_POINTWISE_RSQRT:
+    case CUDNN_POINTWISE_SIN:
+    case CUDNN_POINTWISE_SQRT:
+    case CUDNN_POINTWISE_TAN:
+    case CUDNN_POINTWISE_RELU_FWD:
+    case CUDNN_POINTWISE_TANH_FWD:
+    case CUDNN_POINTWISE_SIGMOID_FWD:
+    case CUDNN_POINTWISE_ELU_FWD:
+    case CUDNN_POINTWISE_GELU_FWD:
+    case CUDNN_POINTWISE_SOFTPLUS_FWD:
+    case CUDNN_POINTWISE_SWISH_FWD:
+    case CUDNN_POINTWISE_GELU_APPROX_TANH_FWD:
+    case CUDNN_POINTWISE_LOGICAL_NOT:
+      expected_inputs = 1;
+      break;
+    case CUDNN_POINTWISE_ADD:
+    case CUDNN_POINTWISE_ADD_SQUARE:
+    case CUDNN_POINTWISE_DIV:
+    case CUDNN_POINTWISE_MAX:
+    case CUDNN_POINTWISE_MIN:
+    case CUDNN_POINTWISE_MOD:
+    case CUDNN_POINTWISE_MUL:
+    case CUDNN_POINTWISE_POW:
+    case CUDNN_POINTWISE_SUB:
+    case CUDNN_POINTWISE_CMP_EQ:
+    case CUDNN_POINTWISE_CMP_NEQ:
+    case CUDNN_POINTWISE_CMP_GT:
+    case CUDNN_POINTWISE_CMP_GE:
+    case CUDNN_POINTWISE_CMP_LT:
+    case CUDNN_POINTWISE_CMP_LE:
+    case CUDNN_POINTWISE_LOGICAL_AND:
+    case CUDNN_POINTWISE_LOGICAL_OR:
+      expected_inputs = 2;
+      break;
+    case CUDNN_POINTWISE_BINARY_SELECT:
+      expected_inputs = 3;
+      break;
+    default:
+      return Status(StatusCode::kInvalidArgument,
+                    "unsupported pointwise mode");
+  }
+  if (num_inputs != expected_inputs)
+    return Status(StatusCode::kInvalidArgument,
+                  "wrong number of inputs for the pointwise mode");
+  return static_cast<cudnnPointwiseMode_t>(mode);
+}
+
+static StatusOr<cudnnConvolutionMode_t> ToCudnnConvolutionMode(int64_t mode) {
+  if (mode != CUDNN_CONVOLUTION && mode != CUDNN_CROSS_CORRELATION)
+    return Status(StatusCode::kInvalidArgument, "unsupported convolution mode");
+  return static_cast<cudnnConvolutionMode_t>(mode);
+}
+
 static StatusOr<std::vector<int64_t>> LoadI64Vec(const iree_vm_list_t* list) {
   std::vector<int64_t> vector(iree_vm_list_size(list));
   for (size_t i = 0; i < vector.size(); ++i) {
@@ -111,7 +501,21 @@ StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::Argument(
   IREE_ASSIGN_OR_RETURN(cudnnDataType_t data_type, ToCudnnDataType(dtype));
   IREE_ASSIGN_OR_RETURN(std::vector<int64_t> dimensions, LoadI64Vec(&*dims));
   std::vector<int64_t> strides = GetRowMajorStrides(dimensions);
-  return CreateArgument(&syms_, dimensions, strides, uid, data_type, alignment);
+  return CreateArgument(syms_, dimensions, strides, uid, data_type, alignment);
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::StridedArgument(
+    int64_t dtype, const vm::ref<iree_vm_list_t> dims,
+    const vm::ref<iree_vm_list_t> strides, int64_t uid, int64_t alignment) {
+  IREE_ASSIGN_OR_RETURN(cudnnDataType_t data_type, ToCudnnDataType(dtype));
+  IREE_ASSIGN_OR_RETURN(std::vector<int64_t> dimensions, LoadI64Vec(&*dims));
+  IREE_ASSIGN_OR_RETURN(std::vector<int64_t> strides_vec,
+                        LoadI64Vec(&*strides));
+  if (dimensions.size() != strides_vec.size())
+    return Status(StatusCode::kInvalidArgument,
+                  "number of strides does not match the tensor rank");
+  return CreateArgument(syms_, dimensions, strides_vec, uid, data_type,
+                        alignment);
 }
 
 Status CuDNNModuleState::PrintTensorDebug(const vm::ref<CuDNNTensor> tensor) {
@@ -127,24 +531,392 @@ Status CuDNNModuleState::PrintGraphDebug(
   return OkStatus();
 }
 
+Status CuDNNModuleState::PrintExecutableDebug(
+    const vm::ref<CuDNNExecutable> executable) {
+  for (auto& plan : executable->plans()) {
+    std::string desc = plan.describe();
+    fprintf(stderr, "Execution plan: %s\n", desc.c_str());
+  }
+
+  const CuDNNWorkspaceLimitReport& report =
+      executable->workspace_limit_report();
+  fprintf(stderr,
+          "Workspace limit: %" PRId64 " bytes dropped plans: %" PRId64
+          " first plan rank: %" PRId64 " preferred plan workspace: %" PRId64
+          " bytes\n",
+          report.workspace_limit, report.num_dropped_plans,
+          report.first_plan_rank, report.preferred_workspace_size);
+  return OkStatus();
+}
+
+Status CuDNNModuleState::PrintPlanCacheDebug() {
+  PlanCacheStats stats = plan_cache_->stats();
+  fprintf(stderr,
+          "Plan cache: hits: %" PRId64 " misses: %" PRId64
+          " evictions: %" PRId64 " entries: %" PRId64 " size: %zu bytes\n",
+          stats.hits, stats.misses, stats.evictions, stats.num_entries,
+          stats.size_bytes);
+  return OkStatus();
+}
+
+// Returns a memoized executables cache key for the graph key and dimensions.
+static uint64_t MemoizedExecutableKey(int64_t key,
+                                      const std::vector<int64_t>& shape) {
+  uint64_t hash = static_cast<uint64_t>(key);
+  for (int64_t dim : shape)
+    hash ^= static_cast<uint64_t>(dim) + 0x9e3779b97f4a7c15ull + (hash << 6) +
+            (hash >> 2);
+  return hash;
+}
+
+StatusOr<std::tuple<int32_t, vm::ref<CuDNNExecutable>>>
+CuDNNModuleState::LookupExecutable(int64_t key,
+                                   const vm::ref<iree_vm_list_t> shape) {
+  IREE_ASSIGN_OR_RETURN(std::vector<int64_t> dims, LoadI64Vec(&*shape));
+  auto memoized =
+      memoized_executables_.Lookup(MemoizedExecutableKey(key, dims));
+  if (!memoized || memoized->key != key || memoized->shape != dims)
+    return std::make_tuple(0, vm::ref<CuDNNExecutable>());
+  return std::make_tuple(1, std::move(memoized->executable));
+}
+
+Status CuDNNModuleState::MemoizeExecutable(
+    int64_t key, const vm::ref<iree_vm_list_t> shape,
+    const vm::ref<CuDNNExecutable> executable) {
+  IREE_ASSIGN_OR_RETURN(std::vector<int64_t> dims, LoadI64Vec(&*shape));
+  uint64_t cache_key = MemoizedExecutableKey(key, dims);
+  memoized_executables_.Insert(
+      cache_key, MemoizedExecutable{key, std::move(dims), executable},
+      /*size_bytes=*/1);
+  return OkStatus();
+}
+
+Status CuDNNModuleState::PrintWorkspaceArenaDebug() {
+  WorkspaceArenaStats stats = workspace_arena_->stats();
+  fprintf(stderr,
+          "Workspace arena: peak: %zu bytes capacity: %zu bytes grows: %" PRId64
+          " allocations: %" PRId64 "\n",
+          stats.peak_bytes, stats.capacity_bytes, stats.num_grows,
+          stats.num_allocations);
+  return OkStatus();
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::Scalar(int64_t dtype,
+                                                        float value,
+                                                        int64_t rank,
+                                                        int64_t uid) {
+  IREE_ASSIGN_OR_RETURN(cudnnDataType_t data_type, ToCudnnDataType(dtype));
+  return CreateScalar(syms_, data_type, value, rank, uid);
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::PointwiseUnary(
+    int64_t mode, const vm::ref<CuDNNTensor> x, float lower_clip,
+    float upper_clip, float alpha, int64_t uid, int64_t alignment) {
+  IREE_ASSIGN_OR_RETURN(cudnnPointwiseMode_t pointwise_mode,
+                        ToCudnnPointwiseMode(mode, 1));
+
+  CuDNNPointwiseAttrs attrs;
+  attrs.lower_clip = lower_clip;
+  attrs.upper_clip = upper_clip;
+  switch (pointwise_mode) {
+    case CUDNN_POINTWISE_RELU_FWD:
+      attrs.lower_clip_slope = alpha;
+      break;
+    case CUDNN_POINTWISE_ELU_FWD:
+      attrs.elu_alpha = alpha;
+      break;
+    case CUDNN_POINTWISE_SOFTPLUS_FWD:
+      attrs.softplus_beta = alpha;
+      break;
+    case CUDNN_POINTWISE_SWISH_FWD:
+      attrs.swish_beta = alpha;
+      break;
+    default:
+      break;
+  }
+
+  return CreatePointwise(syms_, pointwise_mode, {x.get()}, uid, alignment,
+                         attrs);
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::PointwiseBinary(
+    int64_t mode, const vm::ref<CuDNNTensor> x, const vm::ref<CuDNNTensor> b,
+    int64_t uid, int64_t alignment) {
+  IREE_ASSIGN_OR_RETURN(cudnnPointwiseMode_t pointwise_mode,
+                        ToCudnnPointwiseMode(mode, 2));
+  return CreatePointwise(syms_, pointwise_mode, {x.get(), b.get()}, uid,
+                         alignment);
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::PointwiseTernary(
+    int64_t mode, const vm::ref<CuDNNTensor> x, const vm::ref<CuDNNTensor> b,
+    const vm::ref<CuDNNTensor> t, int64_t uid, int64_t alignment) {
+  IREE_ASSIGN_OR_RETURN(cudnnPointwiseMode_t pointwise_mode,
+                        ToCudnnPointwiseMode(mode, 3));
+  return CreatePointwise(syms_, pointwise_mode, {x.get(), b.get(), t.get()},
+                         uid, alignment);
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::PointwiseAdd(
+    const vm::ref<CuDNNTensor> lhs, const vm::ref<CuDNNTensor> rhs, int64_t uid,
+    int64_t alignment) {
+  return CreatePointwiseAdd(syms_, *lhs, *rhs, uid, alignment);
+}
+
 StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::PointwiseRelu(
     const vm::ref<CuDNNTensor> input, float lower_clip, float upper_clip,
     int64_t uid, int64_t alignment) {
-  return CreatePointwiseRelu(&syms_, *input, lower_clip, upper_clip, uid,
+  return CreatePointwiseRelu(syms_, *input, lower_clip, upper_clip, uid,
                              alignment);
 }
 
+StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::PointwiseGelu(
+    const vm::ref<CuDNNTensor> input, int64_t uid, int64_t alignment) {
+  return CreatePointwiseGelu(syms_, *input, uid, alignment);
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::Matmul(
+    const vm::ref<CuDNNTensor> a, const vm::ref<CuDNNTensor> b, int64_t uid,
+    int64_t alignment) {
+  return CreateMatmul(syms_, *a, *b, uid, alignment);
+}
+
+StatusOr<vm::ref<CuDNNTensor>> CuDNNModuleState::Convolution(
+    const vm::ref<CuDNNTensor> x, const vm::ref<CuDNNTensor> w, int64_t mode,
+    float alpha, float beta, const vm::ref<iree_vm_list_t> strides,
+    const vm::ref<iree_vm_list_t> pre_padding,
+    const vm::ref<iree_vm_list_t> post_padding,
+    const vm::ref<iree_vm_list_t> dilations, int64_t uid, int64_t alignment,
+    int32_t is_virtual) {
+  CuDNNConvolutionAttrs attrs;
+  IREE_ASSIGN_OR_RETURN(attrs.mode, ToCudnnConvolutionMode(mode));
+  attrs.alpha = alpha;
+  attrs.beta = beta;
+  IREE_ASSIGN_OR_RETURN(attrs.strides, LoadI64Vec(&*strides));
+  IREE_ASSIGN_OR_RETURN(attrs.pre_padding, LoadI64Vec(&*pre_padding));
+  IREE_ASSIGN_OR_RETURN(attrs.post_padding, LoadI64Vec(&*post_padding));
+  IREE_ASSIGN_OR_RETURN(attrs.dilations, LoadI64Vec(&*dilations));
+  return CreateConvolution(syms_, *x, *w, attrs, uid, alignment, is_virtual);
+}
+
 StatusOr<vm::ref<CuDNNOperationGraph>> CuDNNModuleState::CreateGraph(
     const vm::ref<CuDNNTensor> tensor) {
-  return CreateOperationGraph(&syms_, handle_, {tensor.get()});
+  return CreateOperationGraph(syms_, handle_.get(), {tensor.get()});
+}
+
+StatusOr<vm::ref<CuDNNOperationGraph>> CuDNNModuleState::CreateGraphFromList(
+    const vm::ref<iree_vm_list_t> tensors) {
+  iree_host_size_t size = iree_vm_list_size(tensors.get());
+  if (size == 0)
+    return Status(StatusCode::kInvalidArgument,
+                  "cuDNN graph must have at least one result");
+
+  // List keeps all tensors alive while we are building the graph.
+  std::vector<CuDNNTensor*> results(size);
+  for (iree_host_size_t i = 0; i < size; ++i) {
+    iree_vm_ref_t ref = {0};
+    IREE_RETURN_IF_ERROR(iree_vm_list_get_ref_assign(tensors.get(), i, &ref));
+    IREE_RETURN_IF_ERROR(cudnn_tensor_check_deref(ref, &results[i]));
+  }
+
+  return CreateOperationGraph(syms_, handle_.get(), results);
+}
+
+static CuDNNEngineConfig ToEngineConfig(const PlanDatabaseValue& value) {
+  CuDNNEngineConfig config;
+  config.engine_id = value.engine_id;
+  for (auto& [knob, choice] : value.knobs)
+    config.knobs.emplace_back(static_cast<cudnnBackendKnobType_t>(knob),
+                              choice);
+  return config;
+}
+
+static PlanDatabaseValue ToPlanDatabaseValue(const CuDNNEngineConfig& config) {
+  PlanDatabaseValue value;
+  value.engine_id = config.engine_id;
+  for (auto& [knob, choice] : config.knobs)
+    value.knobs.emplace_back(static_cast<int64_t>(knob), choice);
+  return value;
+}
+
+StatusOr<vm::ref<CuDNNExecutable>> CuDNNModuleState::CompileGraph(
+    const vm::ref<CuDNNOperationGraph> graph, int64_t workspace_limit) {
+  workspace_limit = workspace_limit < 0
+                        ? workspace_limit_
+                        : std::min(workspace_limit, workspace_limit_);
+
+  // Executables compiled for the same graph with different workspace limits
+  // can have different execution plans.
+  uint64_t cache_key = PlanCacheKey(graph->fingerprint(), workspace_limit);
+  std::vector<int64_t> signature = GraphSignature(*graph);
+  if (auto cached = plan_cache_->Lookup(cache_key)) {
+    if (cached->fingerprint == graph->fingerprint() &&
+        cached->workspace_limit == workspace_limit &&
+        cached->signature == signature)
+      return std::move(cached->executable);
+  }
+
+  PlanDatabaseKey key{graph->fingerprint(), syms_->cudnnGetVersion(),
+                      compute_capability_, workspace_limit};
+
+  // Try to re-create an executable from the recorded engine config. Recorded
+  // config might be rejected by cuDNN (e.g. if the database was written by a
+  // different build of the library), in this case we fall back on heuristics.
+  vm::ref<CuDNNExecutable> executable;
+  if (plan_database_) {
+    std::optional<PlanDatabaseValue> recorded = plan_database_->Lookup(key);
+    if (recorded) {
+      CuDNNEngineConfig config = ToEngineConfig(*recorded);
+      auto loaded = CreateExecutable(syms_, handle_.get(), *graph,
+                                     {&config, 1}, workspace_limit);
+      if (loaded.ok()) executable = std::move(*loaded);
+    }
+  }
+
+  if (!executable) {
+    IREE_ASSIGN_OR_RETURN(
+        executable,
+        CreateExecutable(syms_, handle_.get(), *graph, workspace_limit));
+
+    bool autotune = autotune_options_.max_candidates > 0 &&
+                    executable->plans().size() > 1;
+    bool autotuned = false;
+    if (autotune) {
+      // Autotuner times execution plans on the stream bound to the handle.
+      // Failing to autotune is not fatal, as the executable keeps execution
+      // plans in the heuristics order.
+      Status status = AutotuneExecutable(syms_, cuda_syms_, cuda_ctx_,
+                                         handle_.get(), *executable,
+                                         autotune_options_)
+                          .status();
+      if (status.ok()) {
+        autotuned = true;
+      } else {
+        fprintf(stderr,
+                "Failed to autotune cuDNN executable, using heuristics "
+                "order: %s\n",
+                status.ToString().c_str());
+      }
+    }
+
+    // Heuristics order is not recorded if autotuning failed, so that the next
+    // run tries to autotune the graph again.
+    bool record = autotune ? autotuned && autotune_options_.persist : true;
+    if (plan_database_ && record) {
+      IREE_RETURN_IF_ERROR(plan_database_->Insert(
+          key, ToPlanDatabaseValue(executable->engine_configs().front())));
+    }
+  }
+
+  size_t size_bytes = executable->ApproximateSizeInBytes();
+  plan_cache_->Insert(cache_key,
+                      CuDNNPlanCacheEntry{graph->fingerprint(), workspace_limit,
+                                          std::move(signature), executable},
+                      size_bytes);
+  return executable;
+}
+
+// Returns a device pointer to the buffer at `index` in the list of buffer views
+// and checks that it is large enough to hold the `tensor`, and that the buffer
+// binding (allocation base pointer plus subspan offset) has at least the
+// alignment declared by the tensor. cuDNN engines selected for the declared
+// alignment use vectorized memory accesses, and can't run on misaligned data.
+static StatusOr<void*> GetDevicePointer(iree_vm_list_t* list, size_t index,
+                                        const CuDNNTensor& tensor) {
+  iree_vm_ref_t ref = {0};
+  IREE_RETURN_IF_ERROR(iree_vm_list_get_ref_assign(list, index, &ref));
+  iree_hal_buffer_view_t* view = nullptr;
+  IREE_RETURN_IF_ERROR(iree_hal_buffer_view_check_deref(ref, &view));
+
+  IREE_ASSIGN_OR_RETURN(size_t size, GetTensorSizeInBytes(tensor));
+  if (iree_hal_buffer_view_byte_length(view) < size)
+    return Status(StatusCode::kInvalidArgument,
+                  "buffer is too small for the cuDNN tensor");
+
+  iree_hal_buffer_t* buffer = iree_hal_buffer_view_buffer(view);
+  CUdeviceptr ptr = iree_hal_cuda_buffer_device_pointer(
+                        iree_hal_buffer_allocated_buffer(buffer)) +
+                    iree_hal_buffer_byte_offset(buffer);
+
+  int64_t alignment = tensor.tensor().getAlignment();
+  if (alignment > 0 && ptr % alignment != 0)
+    return Status(StatusCode::kInvalidArgument,
+                  "buffer is not aligned to the cuDNN tensor alignment");
+
+  return reinterpret_cast<void*>(ptr);
+}
+
+Status CuDNNModuleState::Execute(const vm::ref<CuDNNExecutable> executable,
+                                 const vm::ref<iree_vm_list_t> buffers) {
+  const std::vector<const CuDNNTensor*>& tensors =
+      executable->graph().tensors();
+  if (iree_vm_list_size(buffers.get()) != tensors.size())
+    return Status(StatusCode::kInvalidArgument,
+                  "number of buffers does not match the number of cuDNN graph "
+                  "tensors");
+
+  SmallVector<void*, 8> ptrs(tensors.size());
+  for (size_t i = 0; i < tensors.size(); ++i) {
+    IREE_ASSIGN_OR_RETURN(ptrs[i],
+                          GetDevicePointer(buffers.get(), i, *tensors[i]));
+  }
+
+  const cudnn_frontend::ExecutionPlan& plan = executable->plans().front();
+
+  CUDA_RETURN_IF_ERROR(cuda_syms_, cuCtxPushCurrent(cuda_ctx_),
+                       "cuCtxPushCurrent");
+  // Previous launch is completed, so its workspace can be safely reused.
+  Status status = workspace_arena_->Reset();
+  if (status.ok()) {
+    StatusOr<void*> workspace =
+        workspace_arena_->Allocate(plan.getWorkspaceSize());
+    status = workspace.ok()
+                 ? executable->Execute(handle_.get(), 0, ptrs, *workspace)
+                 : workspace.status();
+  }
+  // Results are visible to the HAL device only when the launch completes.
+  if (status.ok()) {
+    status = CU_RESULT_TO_STATUS(cuda_syms_, cuStreamSynchronize(cuda_stream_),
+                                 "cuStreamSynchronize");
+  }
+  CUcontext popped;
+  CUDA_RETURN_IF_ERROR(cuda_syms_, cuCtxPopCurrent(&popped), "cuCtxPopCurrent");
+  return status;
 }
 
 static const vm::NativeFunction<CuDNNModuleState> kCuDNNModuleFunctions[] = {
     vm::MakeNativeFunction("tensor.arg", &CuDNNModuleState::Argument),
+    vm::MakeNativeFunction("tensor.arg.strided",
+                           &CuDNNModuleState::StridedArgument),
+    vm::MakeNativeFunction("tensor.scalar", &CuDNNModuleState::Scalar),
+    vm::MakeNativeFunction("pointwise.unary",
+                           &CuDNNModuleState::PointwiseUnary),
+    vm::MakeNativeFunction("pointwise.binary",
+                           &CuDNNModuleState::PointwiseBinary),
+    vm::MakeNativeFunction("pointwise.ternary",
+                           &CuDNNModuleState::PointwiseTernary),
+    vm::MakeNativeFunction("pointwise_add", &CuDNNModuleState::PointwiseAdd),
     vm::MakeNativeFunction("pointwise_relu", &CuDNNModuleState::PointwiseRelu),
+    vm::MakeNativeFunction("pointwise_gelu", &CuDNNModuleState::PointwiseGelu),
+    vm::MakeNativeFunction("matmul", &CuDNNModuleState::Matmul),
+    vm::MakeNativeFunction("convolution", &CuDNNModuleState::Convolution),
     vm::MakeNativeFunction("graph.create", &CuDNNModuleState::CreateGraph),
+    vm::MakeNativeFunction("graph.create.list",
+                           &CuDNNModuleState::CreateGraphFromList),
+    vm::MakeNativeFunction("graph.compile", &CuDNNModuleState::CompileGraph),
+    vm::MakeNativeFunction("graph.execute", &CuDNNModuleState::Execute),
+    vm::MakeNativeFunction("executable.lookup",
+                           &CuDNNModuleState::LookupExecutable),
+    vm::MakeNativeFunction("executable.memoize",
+                           &CuDNNModuleState::MemoizeExecutable),
     vm::MakeNativeFunction("debug.tensor", &CuDNNModuleState::PrintTensorDebug),
     vm::MakeNativeFunction("debug.graph", &CuDNNModuleState::PrintGraphDebug),
+    vm::MakeNativeFunction("debug.executable",
+                           &CuDNNModuleState::PrintExecutableDebug),
+    vm::MakeNativeFunction("debug.plan_cache",
+                           &CuDNNModuleState::PrintPlanCacheDebug),
+    vm::MakeNativeFunction("debug.workspace_arena",
+                           &CuDNNModuleState::PrintWorkspaceArenaDebug),
 };
 
 //===----------------------------------------------------------------------===//
@@ -154,7 +926,13 @@ static const vm::NativeFunction<CuDNNModuleState> kCuDNNModuleFunctions[] = {
 class CuDNNModule final : public vm::NativeModule<CuDNNModuleState> {
  public:
   CuDNNModule(iree_vm_instance_t* instance, iree_hal_device_t* device,
-              iree_allocator_t host_allocator, CUcontext cuda_ctx);
+              iree_allocator_t host_allocator, CUcontext cuda_ctx,
+              CUstream cuda_stream, int64_t compute_capability,
+              iree_hal_cuda_dynamic_symbols_t cuda_syms,
+              openxla_cudnn_dynamic_symbols_t syms,
+              std::unique_ptr<PlanDatabase> plan_database,
+              int64_t workspace_limit, AutotuneOptions autotune_options);
+  ~CuDNNModule() override;
 
   StatusOr<std::unique_ptr<CuDNNModuleState>> CreateState(
       iree_allocator_t host_allocator) override;
@@ -170,32 +948,107 @@ class CuDNNModule final : public vm::NativeModule<CuDNNModuleState> {
 
   // CUDA context bound to the instance of a HAL CUDA device.
   CUcontext cuda_ctx_;
+
+  // CUDA stream created by the module in the HAL device context, all cuDNN
+  // executables are launched on it. CUDA HAL does not expose its own stream.
+  CUstream cuda_stream_;
+
+  // Compute capability of the CUDA device (e.g. 80 for sm_80).
+  int64_t compute_capability_;
+
+  // CUDA driver symbols used for autotuning (launching execution plans on
+  // scratch buffers outside of HAL command buffers).
+  iree_hal_cuda_dynamic_symbols_t cuda_syms_;
+
+  // cuDNN library is loaded once per module, and symbols are shared with all
+  // module states (and objects created by them).
+  openxla_cudnn_dynamic_symbols_t syms_;
+
+  // cuDNN handles lent to module states and reused by states created for new
+  // VM contexts, because creating a cuDNN handle is expensive.
+  HandlePool handle_pool_;
+
+  // Default plan cache capacity in bytes (see `ApproximateSizeInBytes`).
+  static constexpr size_t kPlanCacheCapacity = 128 * 1024 * 1024;
+
+  // Executables cached across all module states (VM contexts), so that
+  // identical graphs are compiled only once per process.
+  CuDNNPlanCache plan_cache_;
+
+  // Engine configs selected for cuDNN graphs persisted across process runs
+  // (null if plan database is disabled).
+  std::unique_ptr<PlanDatabase> plan_database_;
+
+  // Maximum workspace size (in bytes) of execution plans selected for graphs.
+  int64_t workspace_limit_;
+
+  AutotuneOptions autotune_options_;
 };
 
 CuDNNModule::CuDNNModule(iree_vm_instance_t* instance,
                          iree_hal_device_t* device,
-                         iree_allocator_t host_allocator, CUcontext cuda_ctx)
+                         iree_allocator_t host_allocator, CUcontext cuda_ctx,
+                         CUstream cuda_stream, int64_t compute_capability,
+                         iree_hal_cuda_dynamic_symbols_t cuda_syms,
+                         openxla_cudnn_dynamic_symbols_t syms,
+                         std::unique_ptr<PlanDatabase> plan_database,
+                         int64_t workspace_limit,
+                         AutotuneOptions autotune_options)
     : NativeModule("cudnn", CuDNNModule::kVersion, instance, host_allocator,
                    {kCuDNNModuleFunctions}),
       device_(vm::retain_ref(device)),
-      cuda_ctx_(cuda_ctx) {}
+      cuda_ctx_(cuda_ctx),
+      cuda_stream_(cuda_stream),
+      compute_capability_(compute_capability),
+      cuda_syms_(cuda_syms),
+      syms_(syms),
+      handle_pool_(&syms_),
+      plan_cache_(kPlanCacheCapacity),
+      plan_database_(std::move(plan_database)),
+      workspace_limit_(workspace_limit),
+      autotune_options_(autotune_options) {}
+
+CuDNNModule::~CuDNNModule() {
+  // Failing to persist plan database is not fatal, as engine configs will be
+  // selected again with heuristics in the next run.
+  if (plan_database_) {
+    Status status = plan_database_->Save();
+    if (!status.ok()) {
+      fprintf(stderr, "Failed to save cuDNN plan database: %s\n",
+              status.ToString().c_str());
+    }
+  }
+
+  // Cached executables and cuDNN handles must be destroyed before unloading
+  // cuDNN library. All module states are already destroyed and returned their
+  // handles to the pool.
+  plan_cache_.Clear();
+  handle_pool_.Clear();
+  openxla_cudnn_dynamic_symbols_deinitialize(&syms_);
+
+  // All module states released their workspace on the module stream.
+  IREE_CHECK_OK(CU_RESULT_TO_STATUS(&cuda_syms_, cuStreamDestroy(cuda_stream_),
+                                    "cuStreamDestroy"));
+  iree_hal_cuda_dynamic_symbols_deinitialize(&cuda_syms_);
+}
 
 StatusOr<std::unique_ptr<CuDNNModuleState>> CuDNNModule::CreateState(
     iree_allocator_t host_allocator) {
-  // Load cuDNN library and resolve API symbols.
-  openxla_cudnn_dynamic_symbols_t syms;
-  iree_status_t status =
-      openxla_cudnn_dynamic_symbols_initialize(host_allocator, &syms);
-  if (!iree_status_is_ok(status)) return status;
-
-  // Create a cuDNN handle for the new state object.
-  cudnnHandle_t handle;
-  // TODO: We must guarantee that `cuda_ctx_` is current when we create cuDNN
-  // handle. Currently we rely on implicit guarantee that module is loaded
-  // immediately after device is created, however it might not always be true?
-  CUDNN_RETURN_IF_ERROR(&syms, cudnnCreate(&handle), "cudnnCreate");
+  // Borrow a cuDNN handle for the new state object. Handle must be created in
+  // the CUDA context of the HAL device.
+  CUDA_RETURN_IF_ERROR(&cuda_syms_, cuCtxPushCurrent(cuda_ctx_),
+                       "cuCtxPushCurrent");
+  StatusOr<HandlePool::Handle> handle =
+      handle_pool_.Acquire(cuda_ctx_, cuda_stream_);
+  CUcontext popped;
+  CUDA_RETURN_IF_ERROR(&cuda_syms_, cuCtxPopCurrent(&popped),
+                       "cuCtxPopCurrent");
+  if (!handle.ok()) return handle.status();
 
-  return std::make_unique<CuDNNModuleState>(syms, handle);
+  return std::make_unique<CuDNNModuleState>(
+      &syms_, &cuda_syms_, cuda_ctx_, cuda_stream_, std::move(*handle),
+      &plan_cache_, plan_database_.get(), compute_capability_,
+      workspace_limit_, autotune_options_);
 }
 
 }  // namespace openxla::runtime::nvgpu
@@ -218,15 +1071,180 @@ static iree_status_t RegisterType(iree_vm_ref_type_descriptor_t* descriptor,
   return iree_ok_status();
 }
 
+// Returns compute capability of the device bound to the CUDA context as
+// `major * 10 + minor`.
+static iree_status_t GetComputeCapability(iree_hal_cuda_dynamic_symbols_t* syms,
+                                          CUcontext cuda_ctx,
+                                          int64_t* out_compute_capability) {
+  IREE_RETURN_IF_ERROR(CU_RESULT_TO_STATUS(syms, cuCtxPushCurrent(cuda_ctx),
+                                           "cuCtxPushCurrent"));
+
+  CUdevice device;
+  int major = 0, minor = 0;
+  iree_status_t status =
+      CU_RESULT_TO_STATUS(syms, cuCtxGetDevice(&device), "cuCtxGetDevice");
+  if (iree_status_is_ok(status)) {
+    status = CU_RESULT_TO_STATUS(
+        syms, cuDeviceGetAttribute(
+                  &major, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MAJOR, device),
+        "cuDeviceGetAttribute");
+  }
+  if (iree_status_is_ok(status)) {
+    status = CU_RESULT_TO_STATUS(
+        syms, cuDeviceGetAttribute(
+                  &minor, CU_DEVICE_ATTRIBUTE_COMPUTE_CAPABILITY_MINOR, device),
+        "cuDeviceGetAttribute");
+  }
+
+  CUcontext popped;
+  status = iree_status_join(
+      status,
+      CU_RESULT_TO_STATUS(syms, cuCtxPopCurrent(&popped), "cuCtxPopCurrent"));
+
+  *out_compute_capability = major * 10 + minor;
+  return status;
+}
+
+// Creates a non-blocking CUDA stream in the CUDA context.
+static iree_status_t CreateStream(iree_hal_cuda_dynamic_symbols_t* syms,
+                                  CUcontext cuda_ctx, CUstream* out_stream) {
+  IREE_RETURN_IF_ERROR(CU_RESULT_TO_STATUS(syms, cuCtxPushCurrent(cuda_ctx),
+                                           "cuCtxPushCurrent"));
+  iree_status_t status = CU_RESULT_TO_STATUS(
+      syms, cuStreamCreate(out_stream, CU_STREAM_NON_BLOCKING),
+      "cuStreamCreate");
+  CUcontext popped;
+  return iree_status_join(
+      status,
+      CU_RESULT_TO_STATUS(syms, cuCtxPopCurrent(&popped), "cuCtxPopCurrent"));
+}
+
+// Default maximum workspace size (in bytes) of selected execution plans.
+static constexpr int64_t kDefaultWorkspaceLimit = 1024 * 1024 * 1024;
+
+extern "C" void iree_custom_module_cudnn_options_initialize(
+    iree_custom_module_cudnn_options_t* out_options) {
+  IREE_ASSERT_ARGUMENT(out_options);
+  memset(out_options, 0, sizeof(*out_options));
+  AutotuneOptions autotune_options;
+  out_options->autotune_candidates = autotune_options.max_candidates;
+  out_options->autotune_warmup_iterations = autotune_options.warmup_iterations;
+  out_options->autotune_iterations = autotune_options.iterations;
+  out_options->autotune_persist = autotune_options.persist;
+  out_options->workspace_limit = kDefaultWorkspaceLimit;
+  // Sub-library version checks only diagnose broken cuDNN installations, and
+  // are not resolved unless requested by the user.
+  out_options->capabilities = OPENXLA_CUDNN_CAPABILITY_RUNTIME_FUSION;
+}
+
+// Checks that cuDNN sub-libraries have the same version as the main library.
+// Sub-libraries are loaded lazily by cuDNN 8, and a mismatch otherwise shows up
+// as obscure failures when building execution plans.
+static iree_status_t CheckCuDNNSubLibraries(
+    openxla_cudnn_dynamic_symbols_t* syms) {
+  if (!iree_all_bits_set(syms->capabilities,
+                         OPENXLA_CUDNN_CAPABILITY_VERSION_CHECK))
+    return iree_ok_status();
+
+  CUDNN_RETURN_IF_ERROR(syms, cudnnOpsInferVersionCheck(),
+                        "cudnnOpsInferVersionCheck");
+  CUDNN_RETURN_IF_ERROR(syms, cudnnCnnInferVersionCheck(),
+                        "cudnnCnnInferVersionCheck");
+  return iree_ok_status();
+}
+
 extern "C" iree_status_t iree_custom_module_cudnn_create(
     iree_vm_instance_t* instance, iree_hal_device_t* device,
+    const iree_custom_module_cudnn_options_t* options,
     iree_allocator_t host_allocator, iree_vm_module_t** out_module) {
   IREE_ASSERT_ARGUMENT(out_module);
 
+  iree_custom_module_cudnn_options_t default_options;
+  if (!options) {
+    iree_custom_module_cudnn_options_initialize(&default_options);
+    options = &default_options;
+  }
+
+  if (options->workspace_limit < 0)
+    return iree_make_status(IREE_STATUS_INVALID_ARGUMENT,
+                            "workspace limit must be non-negative");
+
+  AutotuneOptions autotune_options;
+  autotune_options.max_candidates = options->autotune_candidates;
+  autotune_options.warmup_iterations = options->autotune_warmup_iterations;
+  autotune_options.iterations = options->autotune_iterations;
+  autotune_options.persist = options->autotune_persist;
+
   CUcontext cuda_ctx;
   IREE_RETURN_IF_ERROR(iree_hal_cuda_device_get_context(device, &cuda_ctx));
-  auto module =
-      std::make_unique<CuDNNModule>(instance, device, host_allocator, cuda_ctx);
+
+  // Load engine configs selected in previous runs.
+  std::unique_ptr<PlanDatabase> plan_database;
+  if (!iree_string_view_is_empty(options->plan_database_path)) {
+    std::string path(options->plan_database_path.data,
+                     options->plan_database_path.size);
+    auto loaded = PlanDatabase::Load(std::move(path), host_allocator);
+    if (!loaded.ok()) return Status(loaded.status()).release();
+    plan_database = std::move(*loaded);
+  }
+
+  // Load CUDA driver API symbols.
+  iree_hal_cuda_dynamic_symbols_t cuda_syms;
+  IREE_RETURN_IF_ERROR(
+      iree_hal_cuda_dynamic_symbols_initialize(host_allocator, &cuda_syms));
+
+  int64_t compute_capability;
+  iree_status_t status =
+      GetComputeCapability(&cuda_syms, cuda_ctx, &compute_capability);
+
+  // CUDA HAL does not expose the stream it submits work to, so cuDNN
+  // executables are launched on a stream owned by the module, and launches
+  // are synchronized with the host instead of the HAL device queue.
+  CUstream cuda_stream = nullptr;
+  if (iree_status_is_ok(status)) {
+    status = CreateStream(&cuda_syms, cuda_ctx, &cuda_stream);
+  }
+
+  // Load cuDNN library and resolve API symbols only for optional features
+  // requested in the module options (and autotuning if it is enabled).
+  openxla_cudnn_capabilities_t capabilities = options->capabilities;
+  if (autotune_options.max_candidates > 0)
+    capabilities |= OPENXLA_CUDNN_CAPABILITY_AUTOTUNING;
+
+  openxla_cudnn_dynamic_symbols_t syms;
+  if (iree_status_is_ok(status)) {
+    status = openxla_cudnn_dynamic_symbols_initialize(host_allocator,
+                                                      capabilities, &syms);
+    if (iree_status_is_ok(status)) {
+      status = CheckCuDNNSubLibraries(&syms);
+      if (!iree_status_is_ok(status))
+        openxla_cudnn_dynamic_symbols_deinitialize(&syms);
+    }
+  }
+
+  if (!iree_status_is_ok(status)) {
+    if (cuda_stream) cuda_syms.cuStreamDestroy(cuda_stream);
+    iree_hal_cuda_dynamic_symbols_deinitialize(&cuda_syms);
+    return status;
+  }
+
+  if (autotune_options.max_candidates > 0 &&
+      !iree_all_bits_set(syms.capabilities,
+                         OPENXLA_CUDNN_CAPABILITY_AUTOTUNING)) {
+    fprintf(stderr,
+            "cuDNN library does not support autotuning, using heuristics "
+            "order\n");
+    autotune_options.max_candidates = 0;
+  }
+
+  // Publish resolved symbols for cuDNN stubs used by the cudnn_frontend. The
+  // published table is shared by all modules and threads.
+  PublishCuDNNStubs(&syms);
+
+  auto module = std::make_unique<CuDNNModule>(
+      instance, device, host_allocator, cuda_ctx, cuda_stream,
+      compute_capability, cuda_syms, syms, std::move(plan_database),
+      options->workspace_limit, autotune_options);
   *out_module = module.release()->interface();
 
   return iree_ok_status();
@@ -238,5 +1256,7 @@ extern "C" iree_status_t iree_custom_module_cudnn_register_types(
       RegisterType<CuDNNTensor>(&cudnn_tensor_descriptor, "cudnn.tensor"));
   IREE_RETURN_IF_ERROR(RegisterType<CuDNNOperationGraph>(
       &cudnn_operation_graph_descriptor, "cudnn.operation_graph"));
+  IREE_RETURN_IF_ERROR(RegisterType<CuDNNExecutable>(
+      &cudnn_executable_descriptor, "cudnn.executable"));
   return iree_ok_status();
 }
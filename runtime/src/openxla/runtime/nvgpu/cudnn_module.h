@@ -10,15 +10,56 @@
 #include "iree/base/api.h"
 #include "iree/hal/api.h"
 #include "iree/vm/api.h"
+#include "openxla/runtime/nvgpu/dynamic_symbols.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif  // __cplusplus
 
-iree_status_t iree_custom_module_cudnn_create(iree_vm_instance_t* instance,
-                                              iree_hal_device_t* device,
-                                              iree_allocator_t host_allocator,
-                                              iree_vm_module_t** out_module);
+// Options for the cuDNN custom module.
+typedef struct iree_custom_module_cudnn_options_t {
+  // Path to the plan database file with engine configs selected for cuDNN
+  // graphs in previous runs. Engine configs for new graphs are written back to
+  // the same file when the module is destroyed. Plan database is disabled if
+  // the path is empty.
+  iree_string_view_t plan_database_path;
+
+  // Number of execution plans suggested by cuDNN heuristics that are executed
+  // and timed on the device to select the fastest one when a graph is
+  // compiled. Autotuning is disabled if zero.
+  int32_t autotune_candidates;
+
+  // Number of untimed runs of each autotuning candidate before the timed runs
+  // (e.g. to load kernels and warm up caches).
+  int32_t autotune_warmup_iterations;
+
+  // Number of timed runs of each autotuning candidate.
+  int32_t autotune_iterations;
+
+  // Whether autotuning results are recorded in the plan database.
+  bool autotune_persist;
+
+  // Maximum workspace size (in bytes) that an execution plan selected for a
+  // cuDNN graph can request. Execution plans requesting more workspace are
+  // dropped, even if cuDNN heuristics or autotuning prefer them.
+  int64_t workspace_limit;
+
+  // Optional cuDNN features the module is allowed to use. Requested features
+  // are enabled only if the loaded cuDNN library supports them, and symbols of
+  // features that are not requested are never resolved.
+  openxla_cudnn_capabilities_t capabilities;
+} iree_custom_module_cudnn_options_t;
+
+// Initializes |out_options| to default values.
+void iree_custom_module_cudnn_options_initialize(
+    iree_custom_module_cudnn_options_t* out_options);
+
+// Creates cuDNN custom module for a HAL CUDA |device|. |options| can be NULL
+// to use default options.
+iree_status_t iree_custom_module_cudnn_create(
+    iree_vm_instance_t* instance, iree_hal_device_t* device,
+    const iree_custom_module_cudnn_options_t* options,
+    iree_allocator_t host_allocator, iree_vm_module_t** out_module);
 
 iree_status_t iree_custom_module_cudnn_register_types(
     iree_vm_instance_t* instance);
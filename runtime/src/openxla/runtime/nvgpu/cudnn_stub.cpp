@@ -6,19 +6,30 @@
 
 #include "openxla/runtime/nvgpu/cudnn_stub.h"
 
+#include <mutex>
+
+#include "iree/base/internal/dynamic_library.h"
 #include "openxla/runtime/nvgpu/dynamic_symbols.h"
 
 namespace openxla::runtime::nvgpu {
 
-static thread_local openxla_cudnn_dynamic_symbols_t* cudnn_syms = nullptr;
+namespace internal {
+std::atomic<const openxla_cudnn_dynamic_symbols_t*> cudnn_stubs = nullptr;
+}  // namespace internal
 
-ScopedCuDNNStubs::ScopedCuDNNStubs(openxla_cudnn_dynamic_symbols_t* syms)
-    : syms_(cudnn_syms) {
-  cudnn_syms = syms;
-}
+const openxla_cudnn_dynamic_symbols_t* PublishCuDNNStubs(
+    const openxla_cudnn_dynamic_symbols_t* syms) {
+  static openxla_cudnn_dynamic_symbols_t published;
+  static std::once_flag once;
 
-ScopedCuDNNStubs::~ScopedCuDNNStubs() { cudnn_syms = syms_; }
+  std::call_once(once, [&] {
+    published = *syms;
+    if (published.cudnn_library)
+      iree_dynamic_library_retain(published.cudnn_library);
+    internal::cudnn_stubs.store(&published, std::memory_order_release);
+  });
 
-openxla_cudnn_dynamic_symbols_t* ScopedCuDNNStubs::syms() { return cudnn_syms; }
+  return &published;
+}
 
 }  // namespace openxla::runtime::nvgpu
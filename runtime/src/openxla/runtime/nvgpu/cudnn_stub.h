@@ -7,21 +7,34 @@
 #ifndef OPENXLA_RUNTIME_NVGPU_CUDNN_STUB_H_
 #define OPENXLA_RUNTIME_NVGPU_CUDNN_STUB_H_
 
+#include <atomic>
+
 #include "openxla/runtime/nvgpu/dynamic_symbols.h"
 
 namespace openxla::runtime::nvgpu {
 
-// RAII helper to bind cuDNN stubs to dynamically resolved symbols.
-class ScopedCuDNNStubs {
- public:
-  ScopedCuDNNStubs(openxla_cudnn_dynamic_symbols_t* syms);
-  ~ScopedCuDNNStubs();
-
-  static openxla_cudnn_dynamic_symbols_t* syms();
-
- private:
-  openxla_cudnn_dynamic_symbols_t* syms_;
-};
+// cuDNN stubs (cuDNN API functions required for compiling cudnn_frontend)
+// dispatch to a process-wide symbol table. The table is published once and
+// never changes after that, so stubs can be called from any thread (e.g. when
+// a VM ref release destroys cuDNN descriptors on a different thread) at the
+// cost of a single acquire load.
+
+// Publishes `syms` as the process-wide cuDNN symbol table if no table was
+// published yet, and returns the published table. Symbols are copied into
+// static storage and the cuDNN library is retained until the process exits, so
+// the published table outlives the module that resolved it. All tables resolve
+// the same library, so later calls return the first published table.
+const openxla_cudnn_dynamic_symbols_t* PublishCuDNNStubs(
+    const openxla_cudnn_dynamic_symbols_t* syms);
+
+namespace internal {
+extern std::atomic<const openxla_cudnn_dynamic_symbols_t*> cudnn_stubs;
+}  // namespace internal
+
+// Returns the published cuDNN symbol table, or nullptr if it was not published.
+inline const openxla_cudnn_dynamic_symbols_t* CuDNNStubs() {
+  return internal::cudnn_stubs.load(std::memory_order_acquire);
+}
 
 }  // namespace openxla::runtime::nvgpu
 
@@ -11,6 +11,7 @@
 CUDNN_PFN_DECL(cudnnCreate, cudnnHandle_t *)
 CUDNN_PFN_DECL(cudnnDestroy, cudnnHandle_t)
 CUDNN_PFN_DECL_STR_RETURN(cudnnGetErrorString)
+CUDNN_PFN_DECL(cudnnSetStream, cudnnHandle_t, cudaStream_t)
 
 //===----------------------------------------------------------------------===//
 // Functions required for compiling cudnn_frontend (see cudnn_tensor.{h,cpp}).
@@ -23,5 +24,21 @@ CUDNN_PFN_DECL(cudnnBackendSetAttribute, cudnnBackendDescriptor_t,
 CUDNN_PFN_DECL(cudnnBackendCreateDescriptor, cudnnBackendDescriptorType_t,
                cudnnBackendDescriptor_t *)
 CUDNN_PFN_DECL(cudnnBackendDestroyDescriptor, cudnnBackendDescriptor_t)
+CUDNN_PFN_DECL(cudnnBackendExecute, cudnnHandle_t, cudnnBackendDescriptor_t,
+               cudnnBackendDescriptor_t)
+CUDNN_PFN_DECL(cudnnBackendGetAttribute, cudnnBackendDescriptor_t const,
+               cudnnBackendAttributeName_t, cudnnBackendAttributeType_t,
+               int64_t, int64_t *, void *)
 
 CUDNN_PFN_DECL_SIZE_RETURN(cudnnGetVersion);
+
+//===----------------------------------------------------------------------===//
+// Optional functions resolved only for the requested capabilities.
+//===----------------------------------------------------------------------===//
+
+CUDNN_PFN_DECL_OPTIONAL(OPENXLA_CUDNN_CAPABILITY_VERSION_CHECK,
+                        cudnnOpsInferVersionCheck)
+CUDNN_PFN_DECL_OPTIONAL(OPENXLA_CUDNN_CAPABILITY_VERSION_CHECK,
+                        cudnnCnnInferVersionCheck)
+CUDNN_PFN_DECL_OPTIONAL(OPENXLA_CUDNN_CAPABILITY_AUTOTUNING, cudnnGetStream,
+                        cudnnHandle_t, cudaStream_t *)
@@ -22,6 +22,9 @@ static const char* kCuDNNLoaderSearchNames[] = {
 
 #define concat(A, B) A B
 
+// Minimum cuDNN version with runtime fusion engines.
+#define OPENXLA_CUDNN_RUNTIME_FUSION_VERSION 8300
+
 static iree_status_t openxla_cudnn_dynamic_symbols_resolve_all(
     openxla_cudnn_dynamic_symbols_t* syms) {
 #define CUDNN_PFN_DECL(cuDNNSymbolName, ...)                          \
@@ -45,21 +48,47 @@ static iree_status_t openxla_cudnn_dynamic_symbols_resolve_all(
         syms->cudnn_library, kName, (void**)&syms->cuDNNSymbolName)); \
   }
 
+// Optional symbols are not looked up unless their capability is requested,
+// and a missing symbol drops the capability instead of failing.
+#define CUDNN_PFN_DECL_OPTIONAL(capability, cuDNNSymbolName, ...)        \
+  if (iree_all_bits_set(syms->capabilities, capability)) {               \
+    static const char* kName = #cuDNNSymbolName;                         \
+    iree_status_t status = iree_dynamic_library_lookup_symbol(           \
+        syms->cudnn_library, kName, (void**)&syms->cuDNNSymbolName);     \
+    if (iree_status_is_not_found(status)) {                              \
+      iree_status_ignore(status);                                        \
+      syms->capabilities &= ~(openxla_cudnn_capabilities_t)(capability); \
+    } else {                                                             \
+      IREE_RETURN_IF_ERROR(status);                                      \
+    }                                                                    \
+  }
+
 #include "openxla/runtime/nvgpu/dynamic_symbol_tables.h"  // IWYU pragma: export
 
 #undef CUDNN_PFN_DECL
 #undef CUDNN_PFN_DECL_STR_RETURN
+#undef CUDNN_PFN_DECL_SIZE_RETURN
+#undef CUDNN_PFN_DECL_OPTIONAL
+
+  // Capabilities that depend only on the library version.
+  if (iree_all_bits_set(syms->capabilities,
+                        OPENXLA_CUDNN_CAPABILITY_RUNTIME_FUSION) &&
+      syms->cudnnGetVersion() < OPENXLA_CUDNN_RUNTIME_FUSION_VERSION) {
+    syms->capabilities &= ~OPENXLA_CUDNN_CAPABILITY_RUNTIME_FUSION;
+  }
+
   return iree_ok_status();
 }
 
-iree_status_t openxla_cudnn_dynamic_symbols_initialize(
-    iree_allocator_t host_allocator,
+static iree_status_t openxla_cudnn_dynamic_symbols_initialize_from_files(
+    iree_allocator_t host_allocator, iree_host_size_t search_name_count,
+    const char* const* search_names, openxla_cudnn_capabilities_t capabilities,
     openxla_cudnn_dynamic_symbols_t* out_syms) {
   IREE_TRACE_ZONE_BEGIN(z0);
   memset(out_syms, 0, sizeof(*out_syms));
   iree_status_t status = iree_dynamic_library_load_from_files(
-      IREE_ARRAYSIZE(kCuDNNLoaderSearchNames), kCuDNNLoaderSearchNames,
-      IREE_DYNAMIC_LIBRARY_FLAG_NONE, host_allocator, &out_syms->cudnn_library);
+      search_name_count, search_names, IREE_DYNAMIC_LIBRARY_FLAG_NONE,
+      host_allocator, &out_syms->cudnn_library);
   if (iree_status_is_not_found(status)) {
     iree_status_ignore(status);
     IREE_TRACE_ZONE_END(z0);
@@ -68,6 +97,7 @@ iree_status_t openxla_cudnn_dynamic_symbols_initialize(
                             "installed and on path");
   }
   if (iree_status_is_ok(status)) {
+    out_syms->capabilities = capabilities;
     status = openxla_cudnn_dynamic_symbols_resolve_all(out_syms);
   }
   if (!iree_status_is_ok(status)) {
@@ -77,6 +107,24 @@ iree_status_t openxla_cudnn_dynamic_symbols_initialize(
   return status;
 }
 
+iree_status_t openxla_cudnn_dynamic_symbols_initialize(
+    iree_allocator_t host_allocator, openxla_cudnn_capabilities_t capabilities,
+    openxla_cudnn_dynamic_symbols_t* out_syms) {
+  return openxla_cudnn_dynamic_symbols_initialize_from_files(
+      host_allocator, IREE_ARRAYSIZE(kCuDNNLoaderSearchNames),
+      kCuDNNLoaderSearchNames, capabilities, out_syms);
+}
+
+iree_status_t openxla_cudnn_dynamic_symbols_initialize_from_file(
+    iree_allocator_t host_allocator, const char* library_path,
+    openxla_cudnn_capabilities_t capabilities,
+    openxla_cudnn_dynamic_symbols_t* out_syms) {
+  const char* search_names[] = {library_path};
+  return openxla_cudnn_dynamic_symbols_initialize_from_files(
+      host_allocator, IREE_ARRAYSIZE(search_names), search_names, capabilities,
+      out_syms);
+}
+
 void openxla_cudnn_dynamic_symbols_deinitialize(
     openxla_cudnn_dynamic_symbols_t* syms) {
   IREE_TRACE_ZONE_BEGIN(z0);
@@ -15,33 +15,69 @@
 extern "C" {
 #endif  // __cplusplus
 
+// Optional cuDNN features that might be unavailable in the loaded library.
+typedef enum openxla_cudnn_capability_bits_t {
+  OPENXLA_CUDNN_CAPABILITY_NONE = 0u,
+  // Sub-library version checks (`cudnn*VersionCheck`), available only in
+  // cuDNN 8 where the library is split into separately loaded sub-libraries.
+  OPENXLA_CUDNN_CAPABILITY_VERSION_CHECK = 1u << 0,
+  // Runtime fusion engines that compile kernels specialized for the operation
+  // graph at run time (cuDNN 8.3 and later).
+  OPENXLA_CUDNN_CAPABILITY_RUNTIME_FUSION = 1u << 1,
+  // Timing of execution plans on the device to select the fastest one
+  // (`cudnnGetStream` to time plans on the stream bound to a cuDNN handle).
+  OPENXLA_CUDNN_CAPABILITY_AUTOTUNING = 1u << 2,
+  OPENXLA_CUDNN_CAPABILITY_ALL = OPENXLA_CUDNN_CAPABILITY_VERSION_CHECK |
+                                 OPENXLA_CUDNN_CAPABILITY_RUNTIME_FUSION |
+                                 OPENXLA_CUDNN_CAPABILITY_AUTOTUNING,
+} openxla_cudnn_capability_bits_t;
+typedef uint32_t openxla_cudnn_capabilities_t;
+
 // `openxla_cudnn_dynamic_symbols_t` allow loading dynamically a subset of cuDNN
-// API. It loads all the function declared in `dynamic_symbol_tables.h` and fail
-// if any of the symbol is not available. The functions signatures are matching
-// the declarations in `cudnn.h`. This mechanism is based on dynamic CUDA
-// symbols loading in the IREE HAL backend.
+// API. It loads all the required functions declared in
+// `dynamic_symbol_tables.h` and fails if any of them is not available. Optional
+// functions are loaded only for the requested capabilities, and capabilities
+// with missing functions are dropped from `capabilities`. Optional functions
+// must not be called unless their capability is set. The functions signatures
+// are matching the declarations in `cudnn.h`. This mechanism is based on
+// dynamic CUDA symbols loading in the IREE HAL backend.
 typedef struct openxla_cudnn_dynamic_symbols_t {
   iree_dynamic_library_t* cudnn_library;
 
+  // Capabilities supported by the loaded cuDNN library.
+  openxla_cudnn_capabilities_t capabilities;
+
 #define CUDNN_PFN_DECL(cuDNNSymbolName, ...) \
   cudnnStatus_t (*cuDNNSymbolName)(__VA_ARGS__);
 #define CUDNN_PFN_DECL_STR_RETURN(cuDNNSymbolName, ...) \
   const char* (*cuDNNSymbolName)(__VA_ARGS__);
 #define CUDNN_PFN_DECL_SIZE_RETURN(cuDNNSymbolName, ...) \
   size_t (*cuDNNSymbolName)(__VA_ARGS__);
+#define CUDNN_PFN_DECL_OPTIONAL(capability, cuDNNSymbolName, ...) \
+  cudnnStatus_t (*cuDNNSymbolName)(__VA_ARGS__);
 
 #include "openxla/runtime/nvgpu/dynamic_symbol_tables.h"  // IWYU pragma: export
 
 #undef CUDNN_PFN_DECL
 #undef CUDNN_PFN_DECL_STR_RETURN
 #undef CUDNN_PFN_DECL_SIZE_RETURN
+#undef CUDNN_PFN_DECL_OPTIONAL
 } openxla_cudnn_dynamic_symbols_t;
 
 // Initializes |out_syms| in-place with dynamically loaded cuDNN symbols.
+// Optional symbols are resolved only for the requested |capabilities|.
 // openxla_cudnn_dynamic_symbols_deinitialize must be used to release the
 // library resources.
 iree_status_t openxla_cudnn_dynamic_symbols_initialize(
-    iree_allocator_t host_allocator, openxla_cudnn_dynamic_symbols_t* out_syms);
+    iree_allocator_t host_allocator, openxla_cudnn_capabilities_t capabilities,
+    openxla_cudnn_dynamic_symbols_t* out_syms);
+
+// Same as openxla_cudnn_dynamic_symbols_initialize but loads cuDNN symbols from
+// the library at |library_path| instead of searching the default locations.
+iree_status_t openxla_cudnn_dynamic_symbols_initialize_from_file(
+    iree_allocator_t host_allocator, const char* library_path,
+    openxla_cudnn_capabilities_t capabilities,
+    openxla_cudnn_dynamic_symbols_t* out_syms);
 
 // Deinitializes |syms| by unloading the backing library. All function pointers
 // will be invalidated. They _may_ still work if there are other reasons the
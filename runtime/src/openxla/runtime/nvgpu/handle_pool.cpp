@@ -0,0 +1,103 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/handle_pool.h"
+
+#include <utility>
+
+#include "openxla/runtime/nvgpu/status_util.h"
+
+namespace openxla::runtime::nvgpu {
+
+using namespace iree;
+
+//===----------------------------------------------------------------------===//
+// HandlePool::Handle.
+//===----------------------------------------------------------------------===//
+
+HandlePool::Handle::Handle(Handle&& other)
+    : pool_(std::exchange(other.pool_, nullptr)),
+      ctx_(other.ctx_),
+      stream_(other.stream_),
+      handle_(std::exchange(other.handle_, nullptr)) {}
+
+HandlePool::Handle& HandlePool::Handle::operator=(Handle&& other) {
+  if (this != &other) {
+    Reset();
+    pool_ = std::exchange(other.pool_, nullptr);
+    ctx_ = other.ctx_;
+    stream_ = other.stream_;
+    handle_ = std::exchange(other.handle_, nullptr);
+  }
+  return *this;
+}
+
+void HandlePool::Handle::Reset() {
+  if (pool_) pool_->Release(ctx_, stream_, handle_);
+  pool_ = nullptr;
+  handle_ = nullptr;
+}
+
+//===----------------------------------------------------------------------===//
+// HandlePool.
+//===----------------------------------------------------------------------===//
+
+StatusOr<HandlePool::Handle> HandlePool::Acquire(CUcontext ctx,
+                                                 CUstream stream) {
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    auto it = idle_.find(Key{ctx, stream});
+    if (it != idle_.end() && !it->second.empty()) {
+      cudnnHandle_t handle = it->second.back();
+      it->second.pop_back();
+      ++stats_.num_reused;
+      ++stats_.num_lent;
+      --stats_.num_idle;
+      return Handle(this, ctx, stream, handle);
+    }
+  }
+
+  // Create a new handle outside of the lock, as it might take milliseconds.
+  cudnnHandle_t handle;
+  CUDNN_RETURN_IF_ERROR(syms_, cudnnCreate(&handle), "cudnnCreate");
+
+  // Launch all cuDNN operations on the requested stream, so that they are
+  // ordered with the rest of the work submitted to it.
+  Status status = CUDNN_STATUS_TO_STATUS(syms_, cudnnSetStream(handle, stream));
+  if (!status.ok()) {
+    CUDNN_STATUS_CHECK_OK(syms_, cudnnDestroy(handle));
+    return status;
+  }
+
+  std::lock_guard<std::mutex> lock(mu_);
+  ++stats_.num_created;
+  ++stats_.num_lent;
+  return Handle(this, ctx, stream, handle);
+}
+
+void HandlePool::Release(CUcontext ctx, CUstream stream, cudnnHandle_t handle) {
+  std::lock_guard<std::mutex> lock(mu_);
+  idle_[Key{ctx, stream}].push_back(handle);
+  --stats_.num_lent;
+  ++stats_.num_idle;
+}
+
+void HandlePool::Clear() {
+  std::lock_guard<std::mutex> lock(mu_);
+  for (auto& [key, handles] : idle_) {
+    for (cudnnHandle_t handle : handles)
+      CUDNN_STATUS_CHECK_OK(syms_, cudnnDestroy(handle));
+  }
+  idle_.clear();
+  stats_.num_idle = 0;
+}
+
+HandlePoolStats HandlePool::stats() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return stats_;
+}
+
+}  // namespace openxla::runtime::nvgpu
@@ -0,0 +1,118 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef OPENXLA_RUNTIME_NVGPU_HANDLE_POOL_H_
+#define OPENXLA_RUNTIME_NVGPU_HANDLE_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "iree/base/status_cc.h"
+#include "iree/hal/drivers/cuda/dynamic_symbols.h"
+#include "openxla/runtime/nvgpu/dynamic_symbols.h"
+
+namespace openxla::runtime::nvgpu {
+
+// Statistics of the handle pool usage.
+struct HandlePoolStats {
+  // Number of handles created with `cudnnCreate`.
+  int64_t num_created = 0;
+  // Number of times an idle handle was lent instead of creating a new one.
+  int64_t num_reused = 0;
+  // Number of handles currently lent to the users.
+  int64_t num_lent = 0;
+  // Number of idle handles owned by the pool.
+  int64_t num_idle = 0;
+};
+
+// Thread-safe pool of cuDNN handles keyed by the CUDA context and stream.
+// Creating a cuDNN handle is expensive (it initializes cuDNN for the device
+// and allocates device memory), so handles are lent to cuDNN module states,
+// and reclaimed by the pool when the state is destroyed, to be reused by the
+// next state created for the same CUDA context and stream.
+//
+// Pool must outlive all lent handles.
+class HandlePool {
+ public:
+  // cuDNN handle lent by the pool. Returns the handle to the pool on
+  // destruction.
+  class Handle {
+   public:
+    Handle() = default;
+    ~Handle() { Reset(); }
+
+    Handle(Handle&& other);
+    Handle& operator=(Handle&& other);
+
+    cudnnHandle_t get() const { return handle_; }
+
+    // Returns the handle to the pool.
+    void Reset();
+
+   private:
+    friend class HandlePool;
+
+    Handle(HandlePool* pool, CUcontext ctx, CUstream stream,
+           cudnnHandle_t handle)
+        : pool_(pool), ctx_(ctx), stream_(stream), handle_(handle) {}
+
+    Handle(const Handle&) = delete;
+    Handle& operator=(const Handle&) = delete;
+
+    HandlePool* pool_ = nullptr;
+    CUcontext ctx_ = nullptr;
+    CUstream stream_ = nullptr;
+    cudnnHandle_t handle_ = nullptr;
+  };
+
+  explicit HandlePool(openxla_cudnn_dynamic_symbols_t* syms) : syms_(syms) {}
+  ~HandlePool() { Clear(); }
+
+  // Lends an idle cuDNN handle created for the CUDA context and stream, or
+  // creates a new handle bound to the stream. CUDA context must be current.
+  iree::StatusOr<Handle> Acquire(CUcontext ctx, CUstream stream);
+
+  // Destroys all idle handles. Lent handles are not affected.
+  void Clear();
+
+  HandlePoolStats stats() const;
+
+ private:
+  HandlePool(const HandlePool&) = delete;
+  HandlePool& operator=(const HandlePool&) = delete;
+
+  void Release(CUcontext ctx, CUstream stream, cudnnHandle_t handle);
+
+  struct Key {
+    CUcontext ctx;
+    CUstream stream;
+
+    bool operator==(const Key& other) const {
+      return ctx == other.ctx && stream == other.stream;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& k) const {
+      size_t hash = std::hash<CUcontext>()(k.ctx);
+      return hash ^ (std::hash<CUstream>()(k.stream) + 0x9e3779b97f4a7c15ull +
+                     (hash << 6) + (hash >> 2));
+    }
+  };
+
+  openxla_cudnn_dynamic_symbols_t* syms_;
+
+  mutable std::mutex mu_;
+  std::unordered_map<Key, std::vector<cudnnHandle_t>, KeyHash> idle_;
+  HandlePoolStats stats_;
+};
+
+}  // namespace openxla::runtime::nvgpu
+
+#endif  // OPENXLA_RUNTIME_NVGPU_HANDLE_POOL_H_
@@ -0,0 +1,142 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef OPENXLA_RUNTIME_NVGPU_PLAN_CACHE_H_
+#define OPENXLA_RUNTIME_NVGPU_PLAN_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace openxla::runtime::nvgpu {
+
+// Statistics of the plan cache usage.
+struct PlanCacheStats {
+  int64_t hits = 0;
+  int64_t misses = 0;
+  int64_t evictions = 0;
+  int64_t num_entries = 0;
+  size_t size_bytes = 0;
+};
+
+// Thread-safe LRU cache of compiled cuDNN operation graphs keyed by the graph
+// fingerprint. Cache keeps the total size of cached values under the byte
+// budget by evicting least recently used entries.
+//
+// Keys are hashes, so values should carry the full key they were computed
+// from, and callers should treat a lookup with a mismatching full key as a
+// miss.
+//
+// Value type is a template parameter to be able to test cache logic without
+// loading cuDNN library (cuDNN module instantiates it with executable refs).
+template <typename Value>
+class PlanCache {
+ public:
+  explicit PlanCache(size_t capacity_bytes) : capacity_bytes_(capacity_bytes) {}
+
+  // Returns a cached value for the key and marks it as most recently used.
+  std::optional<Value> Lookup(uint64_t key);
+
+  // Inserts a value of the given size into the cache, replacing an existing
+  // value with the same key, and evicts least recently used entries if the
+  // cache size exceeds the capacity. Values larger than the cache capacity are
+  // not cached.
+  void Insert(uint64_t key, Value value, size_t size_bytes);
+
+  // Evicts all cached values.
+  void Clear();
+
+  PlanCacheStats stats() const;
+
+ private:
+  struct Entry {
+    uint64_t key;
+    Value value;
+    size_t size_bytes;
+  };
+
+  using Entries = std::list<Entry>;
+
+  void Erase(typename Entries::iterator it);
+
+  mutable std::mutex mu_;
+  size_t capacity_bytes_;
+
+  // Cached entries ordered from the most recently used to the least recently
+  // used one, and an index into the entries list.
+  Entries entries_;
+  std::unordered_map<uint64_t, typename Entries::iterator> index_;
+
+  PlanCacheStats stats_;
+};
+
+//===----------------------------------------------------------------------===//
+// PlanCache implementation.
+//===----------------------------------------------------------------------===//
+
+template <typename Value>
+std::optional<Value> PlanCache<Value>::Lookup(uint64_t key) {
+  std::lock_guard<std::mutex> lock(mu_);
+
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    ++stats_.misses;
+    return std::nullopt;
+  }
+
+  ++stats_.hits;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->value;
+}
+
+template <typename Value>
+void PlanCache<Value>::Insert(uint64_t key, Value value, size_t size_bytes) {
+  std::lock_guard<std::mutex> lock(mu_);
+
+  if (auto it = index_.find(key); it != index_.end()) Erase(it->second);
+  if (size_bytes > capacity_bytes_) return;
+
+  entries_.push_front(Entry{key, std::move(value), size_bytes});
+  index_[key] = entries_.begin();
+  stats_.size_bytes += size_bytes;
+  ++stats_.num_entries;
+
+  while (stats_.size_bytes > capacity_bytes_) {
+    Erase(std::prev(entries_.end()));
+    ++stats_.evictions;
+  }
+}
+
+template <typename Value>
+void PlanCache<Value>::Clear() {
+  std::lock_guard<std::mutex> lock(mu_);
+  entries_.clear();
+  index_.clear();
+  stats_.size_bytes = 0;
+  stats_.num_entries = 0;
+}
+
+template <typename Value>
+PlanCacheStats PlanCache<Value>::stats() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  return stats_;
+}
+
+template <typename Value>
+void PlanCache<Value>::Erase(typename Entries::iterator it) {
+  stats_.size_bytes -= it->size_bytes;
+  --stats_.num_entries;
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
+}  // namespace openxla::runtime::nvgpu
+
+#endif  // OPENXLA_RUNTIME_NVGPU_PLAN_CACHE_H_
@@ -0,0 +1,249 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/plan_database.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "iree/base/target_platform.h"
+
+#if defined(IREE_PLATFORM_WINDOWS)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif  // IREE_PLATFORM_WINDOWS
+
+namespace openxla::runtime::nvgpu {
+
+using namespace iree;
+
+static constexpr char kMagic[8] = {'C', 'U', 'D', 'N', 'N', 'P', 'D', 'B'};
+
+struct PlanDatabase::Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t num_records;
+};
+
+struct PlanDatabase::Record {
+  uint64_t graph_fingerprint;
+  uint64_t cudnn_version;
+  int64_t compute_capability;
+  int64_t workspace_limit;
+  int64_t engine_id;
+  int64_t num_knobs;
+  int64_t knobs[kMaxKnobs][2];
+
+  PlanDatabaseKey key() const {
+    return {graph_fingerprint, cudnn_version, compute_capability,
+            workspace_limit};
+  }
+};
+
+PlanDatabase::PlanDatabase(std::string path, iree_file_contents_t* contents)
+    : path_(std::move(path)), contents_(contents) {}
+
+PlanDatabase::~PlanDatabase() {
+  if (contents_) iree_file_contents_free(contents_);
+}
+
+bool PlanDatabase::IsValid(iree_const_byte_span_t data) {
+  static_assert(sizeof(Header) % alignof(Record) == 0,
+                "records must be aligned in the file");
+
+  if (data.data_length < sizeof(Header)) return false;
+
+  Header header;
+  std::memcpy(&header, data.data, sizeof(Header));
+  size_t records_size = data.data_length - sizeof(Header);
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kFormatVersion ||
+      header.record_size != sizeof(Record) ||
+      records_size % sizeof(Record) != 0 ||
+      header.num_records != records_size / sizeof(Record))
+    return false;
+
+  // Records must be sorted to be able to use binary search for lookups, and
+  // must not have more knobs than the record can hold.
+  const uint8_t* records = data.data + sizeof(Header);
+  Record prev, record;
+  for (uint64_t i = 0; i < header.num_records; ++i) {
+    std::memcpy(&record, records + i * sizeof(Record), sizeof(Record));
+    if (record.num_knobs < 0 || record.num_knobs > kMaxKnobs) return false;
+    if (i > 0 && record.key() < prev.key()) return false;
+    prev = record;
+  }
+
+  return true;
+}
+
+StatusOr<std::unique_ptr<PlanDatabase>> PlanDatabase::Load(
+    std::string path, iree_allocator_t host_allocator) {
+  iree_file_contents_t* contents = nullptr;
+  iree_status_t status =
+      iree_file_read_contents(path.c_str(), host_allocator, &contents);
+
+  // Start with an empty database if the file does not exist yet.
+  if (iree_status_is_not_found(status)) {
+    iree_status_ignore(status);
+    return std::unique_ptr<PlanDatabase>(
+        new PlanDatabase(std::move(path), nullptr));
+  }
+  IREE_RETURN_IF_ERROR(status);
+
+  // Database written by an incompatible version (or corrupted) will be
+  // overwritten on save.
+  if (!IsValid(contents->const_buffer)) {
+    iree_file_contents_free(contents);
+    contents = nullptr;
+  }
+
+  return std::unique_ptr<PlanDatabase>(
+      new PlanDatabase(std::move(path), contents));
+}
+
+span<const PlanDatabase::Record> PlanDatabase::loaded_records() const {
+  if (!contents_) return {};
+  const uint8_t* data = contents_->const_buffer.data;
+  const Header* header = reinterpret_cast<const Header*>(data);
+  return {reinterpret_cast<const Record*>(data + sizeof(Header)),
+          static_cast<size_t>(header->num_records)};
+}
+
+std::optional<PlanDatabaseValue> PlanDatabase::Lookup(
+    const PlanDatabaseKey& key) const {
+  std::lock_guard<std::mutex> lock(mu_);
+
+  if (auto it = inserted_.find(key); it != inserted_.end()) return it->second;
+
+  auto records = loaded_records();
+  auto it = std::lower_bound(
+      records.begin(), records.end(), key,
+      [](const Record& record, const PlanDatabaseKey& key) {
+        return record.key() < key;
+      });
+  if (it == records.end() || key < it->key()) return std::nullopt;
+
+  PlanDatabaseValue value;
+  value.engine_id = it->engine_id;
+  for (int64_t i = 0; i < it->num_knobs; ++i)
+    value.knobs.emplace_back(it->knobs[i][0], it->knobs[i][1]);
+  return value;
+}
+
+Status PlanDatabase::Insert(const PlanDatabaseKey& key,
+                            const PlanDatabaseValue& value) {
+  if (value.knobs.size() > kMaxKnobs)
+    return Status(StatusCode::kInvalidArgument,
+                  "too many knobs in the engine config");
+
+  std::lock_guard<std::mutex> lock(mu_);
+  inserted_[key] = value;
+  dirty_ = true;
+  return OkStatus();
+}
+
+// Writes `data` to a new uniquely named file next to `path` and returns its
+// path.
+static StatusOr<std::string> WriteTemporaryFile(
+    const std::string& path, const std::vector<uint8_t>& data) {
+  std::string tmp_path = path + ".XXXXXX";
+
+#if defined(IREE_PLATFORM_WINDOWS)
+  if (_mktemp_s(tmp_path.data(), tmp_path.size() + 1) != 0)
+    return Status(StatusCode::kUnavailable,
+                  "failed to create a temporary cuDNN plan database file");
+  IREE_RETURN_IF_ERROR(iree_file_write_contents(
+      tmp_path.c_str(), iree_make_const_byte_span(data.data(), data.size())));
+#else
+  int fd = mkstemp(tmp_path.data());
+  if (fd < 0)
+    return Status(StatusCode::kUnavailable,
+                  "failed to create a temporary cuDNN plan database file");
+
+  size_t written = 0;
+  while (written < data.size()) {
+    ssize_t n = write(fd, data.data() + written, data.size() - written);
+    if (n < 0) break;
+    written += n;
+  }
+
+  if (close(fd) != 0 || written != data.size()) {
+    std::remove(tmp_path.c_str());
+    return Status(StatusCode::kUnavailable,
+                  "failed to write a temporary cuDNN plan database file");
+  }
+#endif  // IREE_PLATFORM_WINDOWS
+
+  return tmp_path;
+}
+
+Status PlanDatabase::Save() {
+  std::lock_guard<std::mutex> lock(mu_);
+  if (!dirty_) return OkStatus();
+
+  // Merge loaded and inserted records into a sorted array of records.
+  std::vector<Record> records;
+  for (const Record& record : loaded_records()) {
+    if (!inserted_.count(record.key())) records.push_back(record);
+  }
+  for (auto& [key, value] : inserted_) {
+    Record record;
+    std::memset(&record, 0, sizeof(record));
+    record.graph_fingerprint = key.graph_fingerprint;
+    record.cudnn_version = key.cudnn_version;
+    record.compute_capability = key.compute_capability;
+    record.workspace_limit = key.workspace_limit;
+    record.engine_id = value.engine_id;
+    record.num_knobs = value.knobs.size();
+    for (size_t i = 0; i < value.knobs.size(); ++i) {
+      record.knobs[i][0] = value.knobs[i].first;
+      record.knobs[i][1] = value.knobs[i].second;
+    }
+    records.push_back(record);
+  }
+  std::sort(records.begin(), records.end(),
+            [](const Record& a, const Record& b) { return a.key() < b.key(); });
+
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kFormatVersion;
+  header.record_size = sizeof(Record);
+  header.num_records = records.size();
+
+  std::vector<uint8_t> data(sizeof(Header) + records.size() * sizeof(Record));
+  std::memcpy(data.data(), &header, sizeof(Header));
+  std::memcpy(data.data() + sizeof(Header), records.data(),
+              records.size() * sizeof(Record));
+
+  // Write to a temporary file first, so that concurrently starting processes
+  // never observe a partially written database. Every save writes to its own
+  // temporary file, as processes sharing the database can save concurrently.
+  IREE_ASSIGN_OR_RETURN(std::string tmp_path, WriteTemporaryFile(path_, data));
+  if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    std::remove(tmp_path.c_str());
+    return Status(StatusCode::kUnavailable,
+                  "failed to write cuDNN plan database");
+  }
+
+  dirty_ = false;
+  return OkStatus();
+}
+
+size_t PlanDatabase::size() const {
+  std::lock_guard<std::mutex> lock(mu_);
+  size_t size = inserted_.size();
+  for (const Record& record : loaded_records()) {
+    if (!inserted_.count(record.key())) ++size;
+  }
+  return size;
+}
+
+}  // namespace openxla::runtime::nvgpu
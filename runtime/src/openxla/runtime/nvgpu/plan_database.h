@@ -0,0 +1,121 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef OPENXLA_RUNTIME_NVGPU_PLAN_DATABASE_H_
+#define OPENXLA_RUNTIME_NVGPU_PLAN_DATABASE_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "iree/base/api.h"
+#include "iree/base/internal/file_io.h"
+#include "iree/base/internal/span.h"
+#include "iree/base/status_cc.h"
+
+namespace openxla::runtime::nvgpu {
+
+// Plan database stores engine configs selected for cuDNN operation graphs, so
+// that execution plans can be re-created after process restart without
+// querying cuDNN heuristics or autotuning.
+//
+// Engine configs are valid only for the cuDNN library version, the device
+// compute capability and the workspace limit they were selected for, and all of
+// them are part of the key.
+//
+// On-disk format is a header followed by a sorted array of fixed size records,
+// so the file contents can be used in place (e.g. when memory mapped) and
+// looked up with a binary search without any parsing.
+
+struct PlanDatabaseKey {
+  uint64_t graph_fingerprint = 0;
+  uint64_t cudnn_version = 0;
+  int64_t compute_capability = 0;
+  int64_t workspace_limit = 0;
+
+  bool operator<(const PlanDatabaseKey& other) const {
+    return std::tie(graph_fingerprint, cudnn_version, compute_capability,
+                    workspace_limit) <
+           std::tie(other.graph_fingerprint, other.cudnn_version,
+                    other.compute_capability, other.workspace_limit);
+  }
+};
+
+// Engine config in a cuDNN agnostic form: engine global index and pairs of
+// knob type (`cudnnBackendKnobType_t`) and knob value.
+struct PlanDatabaseValue {
+  int64_t engine_id = 0;
+  std::vector<std::pair<int64_t, int64_t>> knobs;
+};
+
+class PlanDatabase {
+ public:
+  // Version of the on-disk format. Files with a different version are ignored.
+  static constexpr uint32_t kFormatVersion = 2;
+
+  // Maximum number of knobs that can be stored for a single engine config.
+  static constexpr int64_t kMaxKnobs = 32;
+
+  ~PlanDatabase();
+
+  // Loads plan database from a file at `path`. If file does not exist, or it
+  // has incompatible format version or invalid records, returns an empty
+  // database that will be written to `path` on save.
+  static iree::StatusOr<std::unique_ptr<PlanDatabase>> Load(
+      std::string path, iree_allocator_t host_allocator);
+
+  // Returns engine config recorded for the key.
+  std::optional<PlanDatabaseValue> Lookup(const PlanDatabaseKey& key) const;
+
+  // Records engine config for the key. Records are not persisted until the
+  // database is saved.
+  iree::Status Insert(const PlanDatabaseKey& key,
+                      const PlanDatabaseValue& value);
+
+  // Writes all records to the database file if there are new records.
+  iree::Status Save();
+
+  // Returns the number of records in the database.
+  size_t size() const;
+
+ private:
+  // File header and record layouts as they stored in the file.
+  struct Header;
+  struct Record;
+
+  PlanDatabase(std::string path, iree_file_contents_t* contents);
+
+  // Returns true if the file contents is a valid plan database with sorted
+  // records.
+  static bool IsValid(iree_const_byte_span_t data);
+
+  // Returns records loaded from the file.
+  iree::span<const Record> loaded_records() const;
+
+  std::string path_;
+
+  mutable std::mutex mu_;
+
+  // File contents with records loaded from the database file (can be null).
+  iree_file_contents_t* contents_;
+
+  // Records inserted after the database was loaded. New records take priority
+  // over the loaded ones.
+  std::map<PlanDatabaseKey, PlanDatabaseValue> inserted_;
+
+  // True if database has records that are not written to the file.
+  bool dirty_ = false;
+};
+
+}  // namespace openxla::runtime::nvgpu
+
+#endif  // OPENXLA_RUNTIME_NVGPU_PLAN_DATABASE_H_
@@ -0,0 +1,77 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef OPENXLA_RUNTIME_NVGPU_SMALL_VECTOR_H_
+#define OPENXLA_RUNTIME_NVGPU_SMALL_VECTOR_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "iree/base/internal/span.h"
+
+namespace openxla::runtime::nvgpu {
+
+// A vector of trivially copyable values that keeps up to `N` elements inline
+// and does not allocate heap memory unless it grows larger than that. It is
+// used on the hot path of launching cuDNN executables, where graphs typically
+// have only a handful of tensors.
+template <typename T, size_t N>
+class SmallVector {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SmallVector supports only trivially copyable types");
+
+ public:
+  SmallVector() = default;
+  explicit SmallVector(size_t size) { resize(size); }
+  explicit SmallVector(iree::span<const T> values) { assign(values); }
+
+  void resize(size_t size) {
+    if (size > N) {
+      if (size_ <= N) heap_.assign(inline_.begin(), inline_.begin() + size_);
+      heap_.resize(size);
+    } else if (size_ > N) {
+      std::copy_n(heap_.begin(), size, inline_.begin());
+    }
+    size_ = size;
+  }
+
+  void assign(iree::span<const T> values) {
+    resize(values.size());
+    std::copy(values.begin(), values.end(), data());
+  }
+
+  T* data() { return size_ > N ? heap_.data() : inline_.data(); }
+  const T* data() const { return size_ > N ? heap_.data() : inline_.data(); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  T& operator[](size_t index) { return data()[index]; }
+  const T& operator[](size_t index) const { return data()[index]; }
+
+  T* begin() { return data(); }
+  T* end() { return data() + size_; }
+  const T* begin() const { return data(); }
+  const T* end() const { return data() + size_; }
+
+  operator iree::span<const T>() const { return {data(), size_}; }
+
+  bool operator==(iree::span<const T> other) const {
+    return size_ == other.size() && std::equal(begin(), end(), other.begin());
+  }
+
+ private:
+  std::array<T, N> inline_;
+  std::vector<T> heap_;
+  size_t size_ = 0;
+};
+
+}  // namespace openxla::runtime::nvgpu
+
+#endif  // OPENXLA_RUNTIME_NVGPU_SMALL_VECTOR_H_
@@ -0,0 +1,102 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/autotuner.h"
+
+#include <optional>
+#include <vector>
+
+#include "iree/testing/gtest.h"
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+using iree::Status;
+using iree::StatusCode;
+using iree::StatusOr;
+
+// Fake timer that returns pre-defined execution times for a list of stub
+// candidates (nullopt if the candidate fails to run).
+class FakeTimer : public AutotuneTimer {
+ public:
+  explicit FakeTimer(std::vector<std::optional<float>> times_ms)
+      : times_ms_(std::move(times_ms)) {}
+
+  StatusOr<float> Measure(size_t candidate, int64_t warmup_iterations,
+                          int64_t iterations) override {
+    measured_.push_back(candidate);
+    warmup_iterations_ = warmup_iterations;
+    iterations_ = iterations;
+    if (!times_ms_[candidate])
+      return Status(StatusCode::kInternal, "candidate failed");
+    return *times_ms_[candidate];
+  }
+
+  std::vector<size_t> measured_;
+  int64_t warmup_iterations_ = 0;
+  int64_t iterations_ = 0;
+
+ private:
+  std::vector<std::optional<float>> times_ms_;
+};
+
+static AutotuneOptions Options(int64_t max_candidates) {
+  AutotuneOptions options;
+  options.max_candidates = max_candidates;
+  options.warmup_iterations = 2;
+  options.iterations = 5;
+  return options;
+}
+
+TEST(AutotunerTest, SelectFastestCandidate) {
+  FakeTimer timer({3.0f, 1.0f, 2.0f});
+  auto result = Autotune(3, Options(3), timer);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->selected, 1);
+  EXPECT_EQ(result->times_ms.size(), 3);
+  EXPECT_EQ(timer.warmup_iterations_, 2);
+  EXPECT_EQ(timer.iterations_, 5);
+}
+
+TEST(AutotunerTest, MeasureOnlyTopCandidates) {
+  FakeTimer timer({3.0f, 2.0f, 1.0f, 0.5f});
+  auto result = Autotune(4, Options(2), timer);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->selected, 1);
+  EXPECT_EQ(timer.measured_, std::vector<size_t>({0, 1}));
+}
+
+TEST(AutotunerTest, PreferEarlierCandidateOnTie) {
+  FakeTimer timer({2.0f, 1.0f, 1.0f});
+  auto result = Autotune(3, Options(3), timer);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->selected, 1);
+}
+
+TEST(AutotunerTest, SkipFailedCandidates) {
+  FakeTimer timer({std::nullopt, 2.0f, std::nullopt});
+  auto result = Autotune(3, Options(3), timer);
+  ASSERT_TRUE(result.ok());
+  EXPECT_EQ(result->selected, 1);
+  EXPECT_FALSE(result->times_ms[0].has_value());
+  EXPECT_FALSE(result->times_ms[2].has_value());
+}
+
+TEST(AutotunerTest, AllCandidatesFailed) {
+  FakeTimer timer({std::nullopt, std::nullopt});
+  auto result = Autotune(2, Options(2), timer);
+  EXPECT_FALSE(result.ok());
+}
+
+TEST(AutotunerTest, InvalidOptions) {
+  FakeTimer timer({1.0f});
+  EXPECT_FALSE(Autotune(1, Options(0), timer).ok());
+  EXPECT_FALSE(Autotune(0, Options(1), timer).ok());
+  EXPECT_TRUE(timer.measured_.empty());
+}
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
@@ -0,0 +1,48 @@
+// RUN: iree-compile %s --iree-plugin=openxla_nvgpu --openxla-nvgpu-enable-cudnn --iree-hal-target-backends=cuda | openxla-runner - conv_relu.main | FileCheck %s
+
+// Unlike `execute.mlir` this test does not call cuDNN module functions
+// explicitly: the compiler plugin outlines StableHLO convolution with a relu
+// epilogue into a cuDNN graph and lowers it to cuDNN module calls.
+module @conv_relu {
+
+  func.func @main() {
+    %c0 = arith.constant 0 : index
+    %c2 = arith.constant 2 : index
+
+    %input = util.unfoldable_constant dense<[[[
+      [-1.0, 2.0, 10.0, 3.0], [4.0, -5.0, 6.0, 12.0]
+    ]]]> : tensor<1x1x2x4xf32>
+    %filter = util.unfoldable_constant dense<2.0> : tensor<1x1x1x1xf32>
+    %zero = stablehlo.constant dense<0.0> : tensor<1x1x2x4xf32>
+
+    // 1x1 convolution scales the input by 2.
+    %conv = stablehlo.convolution(%input, %filter)
+              dim_numbers = [b, f, 0, 1]x[o, i, 0, 1]->[b, f, 0, 1],
+              window = {stride = [1, 1], pad = [[0, 0], [0, 0]],
+                        rhs_dilate = [1, 1]}
+              {batch_group_count = 1 : i64, feature_group_count = 1 : i64}
+            : (tensor<1x1x2x4xf32>, tensor<1x1x1x1xf32>)
+              -> tensor<1x1x2x4xf32>
+    %relu = stablehlo.maximum %conv, %zero : tensor<1x1x2x4xf32>
+
+    // Check that negative values were replaced with zeros, and positive values
+    // were scaled.
+    %negative = tensor.extract %relu[%c0, %c0, %c0, %c0] : tensor<1x1x2x4xf32>
+    %positive = tensor.extract %relu[%c0, %c0, %c0, %c2] : tensor<1x1x2x4xf32>
+    %f0 = arith.constant 0.0 : f32
+    %f20 = arith.constant 20.0 : f32
+    %negative_ok = arith.cmpf oeq, %negative, %f0 : f32
+    %positive_ok = arith.cmpf oeq, %positive, %f20 : f32
+    %ok = arith.andi %negative_ok, %positive_ok : i1
+    %status_ok = arith.constant 0 : i32
+    %status_failed = arith.constant 13 : i32
+    %status = arith.select %ok, %status_ok, %status_failed : i32
+    util.status.check_ok %status, "unexpected cuDNN conv relu result"
+
+    return
+  }
+
+}
+
+// CHECK: INVOKE BEGIN conv_relu.main
+// CHECK: INVOKE END conv_relu.main
@@ -0,0 +1,184 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/cudnn_api.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "iree/testing/gtest.h"
+#include "openxla/runtime/nvgpu/cudnn_stub.h"
+#include "openxla/runtime/nvgpu/dynamic_symbols.h"
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Fake cuDNN backend API that does not require loading cuDNN library.
+//===----------------------------------------------------------------------===//
+
+// Number of descriptors created with the fake cuDNN backend API.
+static int64_t num_created_descriptors = 0;
+
+static cudnnStatus_t FakeCreateDescriptor(cudnnBackendDescriptorType_t,
+                                          cudnnBackendDescriptor_t* desc) {
+  ++num_created_descriptors;
+  *desc = nullptr;
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static cudnnStatus_t FakeDestroyDescriptor(cudnnBackendDescriptor_t) {
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static cudnnStatus_t FakeSetAttribute(cudnnBackendDescriptor_t,
+                                      cudnnBackendAttributeName_t,
+                                      cudnnBackendAttributeType_t, int64_t,
+                                      const void*) {
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static cudnnStatus_t FakeGetAttribute(cudnnBackendDescriptor_t const,
+                                      cudnnBackendAttributeName_t,
+                                      cudnnBackendAttributeType_t, int64_t,
+                                      int64_t* count, void*) {
+  if (count) *count = 0;
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static cudnnStatus_t FakeFinalize(cudnnBackendDescriptor_t) {
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static const char* FakeGetErrorString(cudnnStatus_t) { return "fake"; }
+
+static size_t FakeGetVersion() { return CUDNN_VERSION; }
+
+// Returns fake cuDNN symbols published for the cudnn_frontend stubs.
+static openxla_cudnn_dynamic_symbols_t* FakeSymbols() {
+  static openxla_cudnn_dynamic_symbols_t* syms = [] {
+    static openxla_cudnn_dynamic_symbols_t fake = {};
+    fake.cudnnBackendCreateDescriptor = FakeCreateDescriptor;
+    fake.cudnnBackendDestroyDescriptor = FakeDestroyDescriptor;
+    fake.cudnnBackendSetAttribute = FakeSetAttribute;
+    fake.cudnnBackendGetAttribute = FakeGetAttribute;
+    fake.cudnnBackendFinalize = FakeFinalize;
+    fake.cudnnGetErrorString = FakeGetErrorString;
+    fake.cudnnGetVersion = FakeGetVersion;
+    PublishCuDNNStubs(&fake);
+    return &fake;
+  }();
+  return syms;
+}
+
+//===----------------------------------------------------------------------===//
+// Graph fingerprints.
+//===----------------------------------------------------------------------===//
+
+// Parameters of a graph computing clipped relu of a row major argument.
+struct ReluGraph {
+  std::vector<int64_t> dims = {1, 4, 8, 8};
+  cudnnDataType_t dtype = CUDNN_DATA_FLOAT;
+  int64_t arg_uid = 0;
+  int64_t result_uid = 1;
+};
+
+static uint64_t FingerprintOrDie(const ReluGraph& params) {
+  openxla_cudnn_dynamic_symbols_t* syms = FakeSymbols();
+
+  std::vector<int64_t> strides(params.dims.size(), 1);
+  for (size_t i = strides.size() - 1; i > 0; --i)
+    strides[i - 1] = strides[i] * params.dims[i];
+
+  auto arg = CreateArgument(syms, params.dims, strides, params.arg_uid,
+                            params.dtype, /*alignment=*/16);
+  EXPECT_TRUE(arg.ok());
+
+  auto relu = CreatePointwiseRelu(syms, **arg, /*lower_clip=*/0.0,
+                                  /*upper_clip=*/6.0, params.result_uid,
+                                  /*alignment=*/16);
+  EXPECT_TRUE(relu.ok());
+
+  CuDNNTensor* results[] = {relu->get()};
+  auto graph = CreateOperationGraph(syms, /*handle=*/nullptr, results);
+  EXPECT_TRUE(graph.ok());
+  return (*graph)->fingerprint();
+}
+
+TEST(GraphFingerprintTest, EqualForIdenticalGraphs) {
+  EXPECT_EQ(FingerprintOrDie(ReluGraph()), FingerprintOrDie(ReluGraph()));
+}
+
+TEST(GraphFingerprintTest, DifferentDims) {
+  ReluGraph graph;
+  graph.dims = {1, 4, 8, 16};
+  EXPECT_NE(FingerprintOrDie(ReluGraph()), FingerprintOrDie(graph));
+}
+
+TEST(GraphFingerprintTest, DifferentDtype) {
+  ReluGraph graph;
+  graph.dtype = CUDNN_DATA_HALF;
+  EXPECT_NE(FingerprintOrDie(ReluGraph()), FingerprintOrDie(graph));
+}
+
+TEST(GraphFingerprintTest, DifferentUids) {
+  ReluGraph arg_uid;
+  arg_uid.arg_uid = 2;
+  EXPECT_NE(FingerprintOrDie(ReluGraph()), FingerprintOrDie(arg_uid));
+
+  ReluGraph result_uid;
+  result_uid.result_uid = 2;
+  EXPECT_NE(FingerprintOrDie(ReluGraph()), FingerprintOrDie(result_uid));
+}
+
+//===----------------------------------------------------------------------===//
+// Graph construction cost.
+//===----------------------------------------------------------------------===//
+
+// Returns the number of descriptors created by building an operation graph for
+// a residual chain of `num_blocks` blocks: `x[i+1] = add(relu(x[i]), x[i])`.
+static int64_t ResidualGraphCostOrDie(int64_t num_blocks) {
+  openxla_cudnn_dynamic_symbols_t* syms = FakeSymbols();
+
+  std::vector<int64_t> dims = {1, 4, 8, 8};
+  std::vector<int64_t> strides = {256, 64, 8, 1};
+  auto arg = CreateArgument(syms, dims, strides, /*uid=*/0, CUDNN_DATA_FLOAT,
+                            /*alignment=*/16);
+  EXPECT_TRUE(arg.ok());
+
+  iree::vm::ref<CuDNNTensor> x = std::move(*arg);
+  int64_t uid = 1;
+  for (int64_t i = 0; i < num_blocks; ++i) {
+    auto relu = CreatePointwiseRelu(syms, *x, /*lower_clip=*/0.0,
+                                    /*upper_clip=*/6.0, uid++,
+                                    /*alignment=*/16);
+    EXPECT_TRUE(relu.ok());
+    auto add = CreatePointwiseAdd(syms, **relu, *x, uid++, /*alignment=*/16);
+    EXPECT_TRUE(add.ok());
+    x = std::move(*add);
+  }
+
+  int64_t num_created = num_created_descriptors;
+  CuDNNTensor* results[] = {x.get()};
+  auto graph = CreateOperationGraph(syms, /*handle=*/nullptr, results);
+  EXPECT_TRUE(graph.ok());
+  return num_created_descriptors - num_created;
+}
+
+TEST(GraphBuildTest, LinearInNumberOfOperations) {
+  // Operations shared by multiple users are built only once, otherwise every
+  // residual block would double the cost of building the graph.
+  int64_t cost8 = ResidualGraphCostOrDie(8);
+  int64_t cost16 = ResidualGraphCostOrDie(16);
+  int64_t cost32 = ResidualGraphCostOrDie(32);
+  EXPECT_GT(cost16, cost8);
+  EXPECT_EQ(cost32 - cost16, 2 * (cost16 - cost8));
+}
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
@@ -0,0 +1,141 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cstdint>
+
+#include "benchmark/benchmark.h"
+#include "openxla/runtime/nvgpu/cudnn_stub.h"
+#include "openxla/runtime/nvgpu/dynamic_symbols.h"
+
+// Real cuDNN stubs dispatching to the published symbol table.
+#include "openxla/runtime/nvgpu/cudnn_stub.h.inc"
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Fake cuDNN backend API that does not require loading cuDNN library.
+//===----------------------------------------------------------------------===//
+
+static cudnnStatus_t FakeCreateDescriptor(cudnnBackendDescriptorType_t,
+                                          cudnnBackendDescriptor_t* desc) {
+  *desc = nullptr;
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static cudnnStatus_t FakeDestroyDescriptor(cudnnBackendDescriptor_t) {
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static cudnnStatus_t FakeSetAttribute(cudnnBackendDescriptor_t,
+                                      cudnnBackendAttributeName_t,
+                                      cudnnBackendAttributeType_t, int64_t,
+                                      const void*) {
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static cudnnStatus_t FakeFinalize(cudnnBackendDescriptor_t) {
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static const openxla_cudnn_dynamic_symbols_t* FakeSymbols() {
+  static const openxla_cudnn_dynamic_symbols_t* syms = [] {
+    openxla_cudnn_dynamic_symbols_t fake = {};
+    fake.cudnnBackendCreateDescriptor = FakeCreateDescriptor;
+    fake.cudnnBackendDestroyDescriptor = FakeDestroyDescriptor;
+    fake.cudnnBackendSetAttribute = FakeSetAttribute;
+    fake.cudnnBackendFinalize = FakeFinalize;
+    return PublishCuDNNStubs(&fake);
+  }();
+  return syms;
+}
+
+//===----------------------------------------------------------------------===//
+// Thread local symbols table scoped to every cuDNN API call (legacy stubs).
+//===----------------------------------------------------------------------===//
+
+static thread_local const openxla_cudnn_dynamic_symbols_t* scoped_syms;
+
+class ScopedStubs {
+ public:
+  explicit ScopedStubs(const openxla_cudnn_dynamic_symbols_t* syms) {
+    scoped_syms = syms;
+  }
+  ~ScopedStubs() { scoped_syms = nullptr; }
+};
+
+struct ScopedDispatch {
+  static cudnnStatus_t Create(cudnnBackendDescriptor_t* desc) {
+    return scoped_syms->cudnnBackendCreateDescriptor(
+        CUDNN_BACKEND_TENSOR_DESCRIPTOR, desc);
+  }
+  static cudnnStatus_t Set(cudnnBackendDescriptor_t desc, int64_t value) {
+    return scoped_syms->cudnnBackendSetAttribute(
+        desc, CUDNN_ATTR_TENSOR_UNIQUE_ID, CUDNN_TYPE_INT64, 1, &value);
+  }
+  static cudnnStatus_t Finalize(cudnnBackendDescriptor_t desc) {
+    return scoped_syms->cudnnBackendFinalize(desc);
+  }
+  static cudnnStatus_t Destroy(cudnnBackendDescriptor_t desc) {
+    return scoped_syms->cudnnBackendDestroyDescriptor(desc);
+  }
+};
+
+//===----------------------------------------------------------------------===//
+// Process-wide symbols table published once (cuDNN stubs).
+//===----------------------------------------------------------------------===//
+
+struct PublishedDispatch {
+  static cudnnStatus_t Create(cudnnBackendDescriptor_t* desc) {
+    return cudnnBackendCreateDescriptor(CUDNN_BACKEND_TENSOR_DESCRIPTOR, desc);
+  }
+  static cudnnStatus_t Set(cudnnBackendDescriptor_t desc, int64_t value) {
+    return cudnnBackendSetAttribute(desc, CUDNN_ATTR_TENSOR_UNIQUE_ID,
+                                    CUDNN_TYPE_INT64, 1, &value);
+  }
+  static cudnnStatus_t Finalize(cudnnBackendDescriptor_t desc) {
+    return cudnnBackendFinalize(desc);
+  }
+  static cudnnStatus_t Destroy(cudnnBackendDescriptor_t desc) {
+    return cudnnBackendDestroyDescriptor(desc);
+  }
+};
+
+// Simulates building a cuDNN backend descriptor with the cudnn_frontend:
+// create a descriptor, set `num_attrs` attributes, finalize and destroy it.
+template <typename Dispatch>
+static void BuildDescriptor(int64_t num_attrs) {
+  cudnnBackendDescriptor_t desc;
+  benchmark::DoNotOptimize(Dispatch::Create(&desc));
+  for (int64_t i = 0; i < num_attrs; ++i)
+    benchmark::DoNotOptimize(Dispatch::Set(desc, i));
+  benchmark::DoNotOptimize(Dispatch::Finalize(desc));
+  benchmark::DoNotOptimize(Dispatch::Destroy(desc));
+}
+
+// Every cuDNN API call installs thread local symbols before building
+// descriptors, and descriptors can be built only on the installing thread.
+static void BM_ScopedStubs(benchmark::State& state) {
+  const openxla_cudnn_dynamic_symbols_t* syms = FakeSymbols();
+  for (auto _ : state) {
+    ScopedStubs stubs(syms);
+    BuildDescriptor<ScopedDispatch>(state.range(0));
+  }
+}
+
+// Stubs load the published symbols table on every call.
+static void BM_PublishedStubs(benchmark::State& state) {
+  FakeSymbols();
+  for (auto _ : state) {
+    BuildDescriptor<PublishedDispatch>(state.range(0));
+  }
+}
+
+BENCHMARK(BM_ScopedStubs)->Arg(8)->Arg(32)->ThreadRange(1, 8);
+BENCHMARK(BM_PublishedStubs)->Arg(8)->Arg(32)->ThreadRange(1, 8);
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
@@ -0,0 +1,83 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/dynamic_symbols.h"
+
+#include "iree/testing/gtest.h"
+#include "iree/testing/status_matchers.h"
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+// Fake cuDNN libraries built from `fake_cudnn.c` (see CMakeLists.txt).
+//
+//   v8: cuDNN 8.2 with all optional symbols.
+//   v9: cuDNN 9.1 without optional symbols (e.g. sub-library version checks).
+//   invalid: library without any of the required cuDNN symbols.
+static const char* kFakeCuDNNv8 = FAKE_CUDNN_V8_PATH;
+static const char* kFakeCuDNNv9 = FAKE_CUDNN_V9_PATH;
+static const char* kFakeCuDNNInvalid = FAKE_CUDNN_INVALID_PATH;
+
+class DynamicSymbolsTest : public ::testing::Test {
+ protected:
+  iree_status_t Initialize(const char* path,
+                           openxla_cudnn_capabilities_t capabilities) {
+    iree_status_t status = openxla_cudnn_dynamic_symbols_initialize_from_file(
+        iree_allocator_system(), path, capabilities, &syms_);
+    initialized_ = iree_status_is_ok(status);
+    return status;
+  }
+
+  void TearDown() override {
+    if (initialized_) openxla_cudnn_dynamic_symbols_deinitialize(&syms_);
+  }
+
+  openxla_cudnn_dynamic_symbols_t syms_;
+  bool initialized_ = false;
+};
+
+TEST_F(DynamicSymbolsTest, ResolvesRequestedCapabilities) {
+  IREE_ASSERT_OK(Initialize(kFakeCuDNNv8, OPENXLA_CUDNN_CAPABILITY_ALL));
+  EXPECT_EQ(syms_.cudnnGetVersion(), 8200u);
+
+  // Runtime fusion is not supported by cuDNN 8.2.
+  EXPECT_EQ(syms_.capabilities, OPENXLA_CUDNN_CAPABILITY_VERSION_CHECK |
+                                    OPENXLA_CUDNN_CAPABILITY_AUTOTUNING);
+  EXPECT_NE(syms_.cudnnOpsInferVersionCheck, nullptr);
+  EXPECT_NE(syms_.cudnnCnnInferVersionCheck, nullptr);
+  EXPECT_NE(syms_.cudnnGetStream, nullptr);
+}
+
+TEST_F(DynamicSymbolsTest, DropsCapabilitiesWithMissingSymbols) {
+  IREE_ASSERT_OK(Initialize(kFakeCuDNNv9, OPENXLA_CUDNN_CAPABILITY_ALL));
+  EXPECT_EQ(syms_.cudnnGetVersion(), 90100u);
+  EXPECT_EQ(syms_.capabilities, OPENXLA_CUDNN_CAPABILITY_RUNTIME_FUSION);
+}
+
+TEST_F(DynamicSymbolsTest, SkipsNotRequestedCapabilities) {
+  IREE_ASSERT_OK(Initialize(kFakeCuDNNv8, OPENXLA_CUDNN_CAPABILITY_NONE));
+  EXPECT_EQ(syms_.capabilities, OPENXLA_CUDNN_CAPABILITY_NONE);
+
+  // Optional symbols are not resolved if capability was not requested.
+  EXPECT_EQ(syms_.cudnnOpsInferVersionCheck, nullptr);
+  EXPECT_EQ(syms_.cudnnCnnInferVersionCheck, nullptr);
+  EXPECT_EQ(syms_.cudnnGetStream, nullptr);
+}
+
+TEST_F(DynamicSymbolsTest, FailsOnMissingRequiredSymbols) {
+  IREE_EXPECT_STATUS_IS(IREE_STATUS_NOT_FOUND,
+                        Initialize(kFakeCuDNNInvalid,
+                                   OPENXLA_CUDNN_CAPABILITY_NONE));
+}
+
+TEST_F(DynamicSymbolsTest, FailsOnMissingLibrary) {
+  IREE_EXPECT_STATUS_IS(IREE_STATUS_UNAVAILABLE,
+                        Initialize("libcudnn_missing.so",
+                                   OPENXLA_CUDNN_CAPABILITY_ALL));
+}
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
@@ -10,14 +10,37 @@ module @example {
     %dtype: i64, %dims: !util.list<i64>, %uid: i64, %alignment: i64
   ) -> !cudnn.tensor
 
+  func.func private @cudnn.tensor.arg.strided(
+    %dtype: i64, %dims: !util.list<i64>, %strides: !util.list<i64>, %uid: i64,
+    %alignment: i64
+  ) -> !cudnn.tensor
+
   func.func private @cudnn.pointwise_relu(
     %input: !cudnn.tensor, %lower: f32, %upper: f32, %uid: i64, %alignment: i64
   ) -> !cudnn.tensor
 
+  func.func private @cudnn.tensor.scalar(
+    %dtype: i64, %value: f32, %rank: i64, %uid: i64
+  ) -> !cudnn.tensor
+
+  func.func private @cudnn.pointwise.unary(
+    %mode: i64, %x: !cudnn.tensor, %lower: f32, %upper: f32, %alpha: f32,
+    %uid: i64, %alignment: i64
+  ) -> !cudnn.tensor
+
+  func.func private @cudnn.pointwise.binary(
+    %mode: i64, %x: !cudnn.tensor, %b: !cudnn.tensor, %uid: i64,
+    %alignment: i64
+  ) -> !cudnn.tensor
+
   func.func private @cudnn.graph.create(
     %tensor: !cudnn.tensor
   ) -> !cudnn.operation_graph
 
+  func.func private @cudnn.graph.compile(
+    %graph: !cudnn.operation_graph, %workspace_limit: i64
+  ) -> !cudnn.executable
+
   func.func private @cudnn.debug.tensor(
     %tensor: !cudnn.tensor
   )
@@ -26,6 +49,12 @@ module @example {
     %graph: !cudnn.operation_graph
   )
 
+  func.func private @cudnn.debug.executable(
+    %executable: !cudnn.executable
+  )
+
+  func.func private @cudnn.debug.plan_cache()
+
   //===--------------------------------------------------------------------===//
   // Build and execute cuDNN graph.
   //===--------------------------------------------------------------------===//
@@ -39,6 +68,7 @@ module @example {
     %c3 = arith.constant 3 : index
     
     %c128 = arith.constant 128 : i64
+    %rank_i64 = arith.constant 4 : i64
 
     // Tensor UIDs
     %uid0 = arith.constant 0 : i64
@@ -90,6 +120,83 @@ module @example {
     // CHECK: Tag: ReluFwd_
     call @cudnn.debug.graph(%2) : (!cudnn.operation_graph) -> ()
 
+    // Compile operation graph to an executable with the module workspace
+    // limit.
+    %workspace_limit = arith.constant -1 : i64
+    %3 = call @cudnn.graph.compile(%2, %workspace_limit)
+           : (!cudnn.operation_graph, i64) -> !cudnn.executable
+
+    // CHECK: Execution plan: CUDNN_BACKEND_EXECUTION_PLAN_DESCRIPTOR
+    // CHECK: Workspace limit: 1073741824 bytes
+    call @cudnn.debug.executable(%3) : (!cudnn.executable) -> ()
+
+    // Compiling an identical graph returns executable from the plan cache.
+    %4 = call @cudnn.graph.create(%1)
+           : (!cudnn.tensor) -> !cudnn.operation_graph
+    %5 = call @cudnn.graph.compile(%4, %workspace_limit)
+           : (!cudnn.operation_graph, i64) -> !cudnn.executable
+
+    // CHECK: Plan cache: hits: 1 misses: 1 evictions: 0 entries: 1
+    call @cudnn.debug.plan_cache() : () -> ()
+
+    // Create !cudnn.tensor<128x128x128x128xf32, NHWC> with explicit strides.
+    %c1_i64 = arith.constant 1 : i64
+    %c16384 = arith.constant 16384 : i64
+    %c2097152 = arith.constant 2097152 : i64
+    %strides = util.list.create %rank : !util.list<i64>
+    util.list.resize %strides, %rank : !util.list<i64>
+    util.list.set %strides[%c0], %c2097152 : !util.list<i64>
+    util.list.set %strides[%c1], %c1_i64 : !util.list<i64>
+    util.list.set %strides[%c2], %c16384 : !util.list<i64>
+    util.list.set %strides[%c3], %c128 : !util.list<i64>
+
+    %uid2 = arith.constant 2 : i64
+    %6 = call @cudnn.tensor.arg.strided(%dtype, %dims, %strides, %uid2,
+                                        %alignment)
+           : (i64, !util.list<i64>, !util.list<i64>, i64, i64) -> !cudnn.tensor
+
+    // CHECK: Id: 2
+    // CHECK: Str [ 2097152,1,16384,128 ]
+    call @cudnn.debug.tensor(%6) : (!cudnn.tensor) -> ()
+
+    // Create a by-value scalar broadcasted to the rank 4 tensor.
+    %uid3 = arith.constant 3 : i64
+    %scale = arith.constant 2.0 : f32
+    %7 = call @cudnn.tensor.scalar(%dtype, %scale, %rank_i64, %uid3)
+           : (i64, f32, i64, i64) -> !cudnn.tensor
+
+    // CHECK: Id: 3
+    // CHECK: Dim [ 1,1,1,1 ]
+    // CHECK: isByValue: 1
+    call @cudnn.debug.tensor(%7) : (!cudnn.tensor) -> ()
+
+    // Scale NHWC tensor with a scalar (CUDNN_POINTWISE_MUL). Result keeps the
+    // layout of the broadcasted input.
+    %mul = arith.constant 1 : i64
+    %uid4 = arith.constant 4 : i64
+    %8 = call @cudnn.pointwise.binary(%mul, %6, %7, %uid4, %alignment)
+           : (i64, !cudnn.tensor, !cudnn.tensor, i64, i64) -> !cudnn.tensor
+
+    // CHECK: Id: 4
+    // CHECK: Str [ 2097152,1,16384,128 ]
+    // CHECK: isByValue: 0
+    call @cudnn.debug.tensor(%8) : (!cudnn.tensor) -> ()
+
+    // Leaky relu (CUDNN_POINTWISE_RELU_FWD) of the scaled tensor with a slope
+    // below the lower clip passed as `alpha`.
+    %relu = arith.constant 100 : i64
+    %lower = arith.constant 0.0 : f32
+    %upper = arith.constant 0x7F800000 : f32
+    %slope = arith.constant 0.1 : f32
+    %uid5 = arith.constant 5 : i64
+    %9 = call @cudnn.pointwise.unary(%relu, %8, %lower, %upper, %slope, %uid5,
+                                     %alignment)
+           : (i64, !cudnn.tensor, f32, f32, f32, i64, i64) -> !cudnn.tensor
+
+    // CHECK: Id: 5
+    // CHECK: Str [ 2097152,1,16384,128 ]
+    call @cudnn.debug.tensor(%9) : (!cudnn.tensor) -> ()
+
     return
   }
 
@@ -0,0 +1,115 @@
+// RUN: iree-compile %s --iree-hal-target-backends=cuda | openxla-runner - execute.main | FileCheck %s
+
+module @execute {
+
+  //===--------------------------------------------------------------------===//
+  // Import functions from the cuDNN module.
+  //===--------------------------------------------------------------------===//
+
+  func.func private @cudnn.tensor.arg(
+    %dtype: i64, %dims: !util.list<i64>, %uid: i64, %alignment: i64
+  ) -> !cudnn.tensor
+
+  func.func private @cudnn.pointwise_relu(
+    %input: !cudnn.tensor, %lower: f32, %upper: f32, %uid: i64, %alignment: i64
+  ) -> !cudnn.tensor
+
+  func.func private @cudnn.graph.create(
+    %tensor: !cudnn.tensor
+  ) -> !cudnn.operation_graph
+
+  func.func private @cudnn.graph.compile(
+    %graph: !cudnn.operation_graph, %workspace_limit: i64
+  ) -> !cudnn.executable
+
+  func.func private @cudnn.graph.execute(
+    %executable: !cudnn.executable, %buffers: !util.list<!hal.buffer_view>
+  )
+
+  //===--------------------------------------------------------------------===//
+  // Execute cuDNN graph on HAL buffers.
+  //===--------------------------------------------------------------------===//
+
+  func.func @main() {
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c2 = arith.constant 2 : index
+    %c3 = arith.constant 3 : index
+    %c4 = arith.constant 4 : index
+
+    %c1_i64 = arith.constant 1 : i64
+    %c2_i64 = arith.constant 2 : i64
+    %c4_i64 = arith.constant 4 : i64
+
+    // Tensor UIDs
+    %uid0 = arith.constant 0 : i64
+    %uid1 = arith.constant 1 : i64
+
+    // [1, 1, 2, 4]
+    %dims = util.list.create %c4 : !util.list<i64>
+    util.list.resize %dims, %c4 : !util.list<i64>
+    util.list.set %dims[%c0], %c1_i64 : !util.list<i64>
+    util.list.set %dims[%c1], %c1_i64 : !util.list<i64>
+    util.list.set %dims[%c2], %c2_i64 : !util.list<i64>
+    util.list.set %dims[%c3], %c4_i64 : !util.list<i64>
+
+    // CUDNN_DATA_FLOAT
+    %dtype = arith.constant 0 : i64
+
+    // Tensor alignment
+    %alignment = arith.constant 16 : i64
+
+    // Build and compile a graph computing clipped relu.
+    %lower = arith.constant 0.0 : f32
+    %upper = arith.constant 9.0 : f32
+
+    %arg = call @cudnn.tensor.arg(%dtype, %dims, %uid0, %alignment)
+           : (i64, !util.list<i64>, i64, i64) -> !cudnn.tensor
+    %relu = call @cudnn.pointwise_relu(%arg, %lower, %upper, %uid1, %alignment)
+           : (!cudnn.tensor, f32, f32, i64, i64) -> !cudnn.tensor
+    %graph = call @cudnn.graph.create(%relu)
+           : (!cudnn.tensor) -> !cudnn.operation_graph
+    // Pointwise operations do not need any workspace.
+    %workspace_limit = arith.constant 0 : i64
+    %executable = call @cudnn.graph.compile(%graph, %workspace_limit)
+           : (!cudnn.operation_graph, i64) -> !cudnn.executable
+
+    // Prepare buffers for the graph argument and result.
+    %input = util.unfoldable_constant dense<[[[
+      [-1.0, 2.0, 10.0, 3.0], [4.0, -5.0, 6.0, 12.0]
+    ]]]> : tensor<1x1x2x4xf32>
+    %output = util.unfoldable_constant dense<-1.0> : tensor<1x1x2x4xf32>
+
+    // Exported buffers are ready when the execution starts, and the result is
+    // written when the synchronous execution returns.
+    %input_view = hal.tensor.export %input
+           : tensor<1x1x2x4xf32> -> !hal.buffer_view
+    %output_view = hal.tensor.export %output
+           : tensor<1x1x2x4xf32> -> !hal.buffer_view
+
+    // Buffers are bound to graph tensors in the UID order.
+    %buffers = util.list.create %c2 : !util.list<!hal.buffer_view>
+    util.list.resize %buffers, %c2 : !util.list<!hal.buffer_view>
+    util.list.set %buffers[%c0], %input_view : !util.list<!hal.buffer_view>
+    util.list.set %buffers[%c1], %output_view : !util.list<!hal.buffer_view>
+
+    call @cudnn.graph.execute(%executable, %buffers)
+           : (!cudnn.executable, !util.list<!hal.buffer_view>) -> ()
+
+    // Check that the result was clipped by the upper bound.
+    %result = hal.tensor.import %output_view
+           : !hal.buffer_view -> tensor<1x1x2x4xf32>
+    %value = tensor.extract %result[%c0, %c0, %c0, %c2] : tensor<1x1x2x4xf32>
+    %ok = arith.cmpf oeq, %value, %upper : f32
+    %status_ok = arith.constant 0 : i32
+    %status_failed = arith.constant 13 : i32
+    %status = arith.select %ok, %status_ok, %status_failed : i32
+    util.status.check_ok %status, "unexpected cuDNN graph result"
+
+    return
+  }
+
+}
+
+// CHECK: INVOKE BEGIN execute.main
+// CHECK: INVOKE END execute.main
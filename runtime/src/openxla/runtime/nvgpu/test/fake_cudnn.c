@@ -0,0 +1,53 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Fake cuDNN library for testing cuDNN dynamic symbols loader. It exports all
+// symbols declared in `dynamic_symbol_tables.h`, however only `cudnnGetVersion`
+// is called by the loader, and all other functions are never called and
+// declared without arguments. Built with different definitions to simulate
+// different cuDNN versions:
+//
+//   FAKE_CUDNN_VERSION: version returned from `cudnnGetVersion`.
+//   FAKE_CUDNN_OPTIONAL: if defined exports optional symbols.
+//   FAKE_CUDNN_REQUIRED: if defined exports required symbols.
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#define FAKE_CUDNN_EXPORT __declspec(dllexport)
+#else
+#define FAKE_CUDNN_EXPORT __attribute__((visibility("default")))
+#endif  // _WIN32
+
+#if defined(FAKE_CUDNN_REQUIRED)
+#define CUDNN_PFN_DECL(cuDNNSymbolName, ...) \
+  FAKE_CUDNN_EXPORT int cuDNNSymbolName(void) { return 0; }
+#define CUDNN_PFN_DECL_STR_RETURN(cuDNNSymbolName, ...) \
+  FAKE_CUDNN_EXPORT const char* cuDNNSymbolName(void) { return "fake"; }
+#define CUDNN_PFN_DECL_SIZE_RETURN(cuDNNSymbolName, ...) \
+  FAKE_CUDNN_EXPORT size_t cuDNNSymbolName(void) { return FAKE_CUDNN_VERSION; }
+#else
+#define CUDNN_PFN_DECL(cuDNNSymbolName, ...)
+#define CUDNN_PFN_DECL_STR_RETURN(cuDNNSymbolName, ...)
+#define CUDNN_PFN_DECL_SIZE_RETURN(cuDNNSymbolName, ...)
+#endif  // FAKE_CUDNN_REQUIRED
+
+#if defined(FAKE_CUDNN_OPTIONAL)
+#define CUDNN_PFN_DECL_OPTIONAL(capability, cuDNNSymbolName, ...) \
+  FAKE_CUDNN_EXPORT int cuDNNSymbolName(void) { return 0; }
+#else
+#define CUDNN_PFN_DECL_OPTIONAL(capability, cuDNNSymbolName, ...)
+#endif  // FAKE_CUDNN_OPTIONAL
+
+#include "openxla/runtime/nvgpu/dynamic_symbol_tables.h"
+
+#undef CUDNN_PFN_DECL
+#undef CUDNN_PFN_DECL_STR_RETURN
+#undef CUDNN_PFN_DECL_SIZE_RETURN
+#undef CUDNN_PFN_DECL_OPTIONAL
+
+// Keep the library non-empty when it exports no cuDNN symbols.
+FAKE_CUDNN_EXPORT int fake_cudnn(void) { return 0; }
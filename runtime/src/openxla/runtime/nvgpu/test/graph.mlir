@@ -0,0 +1,155 @@
+// RUN: iree-compile %s --iree-hal-target-backends=cuda | openxla-runner - graph.main | FileCheck %s
+
+module @graph {
+
+  //===--------------------------------------------------------------------===//
+  // Import functions from the cuDNN module.
+  //===--------------------------------------------------------------------===//
+
+  func.func private @cudnn.tensor.arg(
+    %dtype: i64, %dims: !util.list<i64>, %uid: i64, %alignment: i64
+  ) -> !cudnn.tensor
+
+  func.func private @cudnn.pointwise_add(
+    %lhs: !cudnn.tensor, %rhs: !cudnn.tensor, %uid: i64, %alignment: i64
+  ) -> !cudnn.tensor
+
+  func.func private @cudnn.pointwise_relu(
+    %input: !cudnn.tensor, %lower: f32, %upper: f32, %uid: i64, %alignment: i64
+  ) -> !cudnn.tensor
+
+  func.func private @cudnn.graph.create(
+    %tensor: !cudnn.tensor
+  ) -> !cudnn.operation_graph
+
+  func.func private @cudnn.graph.create.list(
+    %tensors: !util.list<!cudnn.tensor>
+  ) -> !cudnn.operation_graph
+
+  func.func private @cudnn.debug.graph(
+    %graph: !cudnn.operation_graph
+  )
+
+  //===--------------------------------------------------------------------===//
+  // Build cuDNN graphs with tensors shared between multiple operations.
+  //===--------------------------------------------------------------------===//
+
+  func.func @main() {
+    %rank = arith.constant 4 : index
+
+    %c0 = arith.constant 0 : index
+    %c1 = arith.constant 1 : index
+    %c2 = arith.constant 2 : index
+    %c3 = arith.constant 3 : index
+
+    %c8 = arith.constant 8 : i64
+
+    // [8, 8, 8, 8]
+    %dims = util.list.create %rank : !util.list<i64>
+    util.list.resize %dims, %rank : !util.list<i64>
+    util.list.set %dims[%c0], %c8 : !util.list<i64>
+    util.list.set %dims[%c1], %c8 : !util.list<i64>
+    util.list.set %dims[%c2], %c8 : !util.list<i64>
+    util.list.set %dims[%c3], %c8 : !util.list<i64>
+
+    // CUDNN_DATA_FLOAT
+    %dtype = arith.constant 0 : i64
+
+    // Tensor alignment
+    %alignment = arith.constant 32 : i64
+
+    // Relu clipping
+    %lower = arith.constant 0.0 : f32
+    %upper = arith.constant 9.0 : f32
+
+    //===------------------------------------------------------------------===//
+    // Diamond: relu result `%d1` is shared by two relu operations.
+    //===------------------------------------------------------------------===//
+
+    %d_uid0 = arith.constant 0 : i64
+    %d_uid1 = arith.constant 1 : i64
+    %d_uid2 = arith.constant 2 : i64
+    %d_uid3 = arith.constant 3 : i64
+    %d_uid4 = arith.constant 4 : i64
+
+    %d0 = call @cudnn.tensor.arg(%dtype, %dims, %d_uid0, %alignment)
+            : (i64, !util.list<i64>, i64, i64) -> !cudnn.tensor
+    %d1 = call @cudnn.pointwise_relu(%d0, %lower, %upper, %d_uid1, %alignment)
+            : (!cudnn.tensor, f32, f32, i64, i64) -> !cudnn.tensor
+    %d2 = call @cudnn.pointwise_relu(%d1, %lower, %upper, %d_uid2, %alignment)
+            : (!cudnn.tensor, f32, f32, i64, i64) -> !cudnn.tensor
+    %d3 = call @cudnn.pointwise_relu(%d1, %lower, %upper, %d_uid3, %alignment)
+            : (!cudnn.tensor, f32, f32, i64, i64) -> !cudnn.tensor
+    %d4 = call @cudnn.pointwise_add(%d2, %d3, %d_uid4, %alignment)
+            : (!cudnn.tensor, !cudnn.tensor, i64, i64) -> !cudnn.tensor
+
+    %diamond = call @cudnn.graph.create(%d4)
+                 : (!cudnn.tensor) -> !cudnn.operation_graph
+
+    // CHECK: Graph: CUDNN_BACKEND_OPERATIONGRAPH_DESCRIPTOR has 4operations
+    call @cudnn.debug.graph(%diamond) : (!cudnn.operation_graph) -> ()
+
+    //===------------------------------------------------------------------===//
+    // Multiple results: relu result `%m1` is both a graph result and an input
+    // to the add operation computing another result `%m2`.
+    //===------------------------------------------------------------------===//
+
+    %m_uid0 = arith.constant 200 : i64
+    %m_uid1 = arith.constant 201 : i64
+    %m_uid2 = arith.constant 202 : i64
+
+    %m0 = call @cudnn.tensor.arg(%dtype, %dims, %m_uid0, %alignment)
+            : (i64, !util.list<i64>, i64, i64) -> !cudnn.tensor
+    %m1 = call @cudnn.pointwise_relu(%m0, %lower, %upper, %m_uid1, %alignment)
+            : (!cudnn.tensor, f32, f32, i64, i64) -> !cudnn.tensor
+    %m2 = call @cudnn.pointwise_add(%m1, %m0, %m_uid2, %alignment)
+            : (!cudnn.tensor, !cudnn.tensor, i64, i64) -> !cudnn.tensor
+
+    %results = util.list.create %c2 : !util.list<!cudnn.tensor>
+    util.list.resize %results, %c2 : !util.list<!cudnn.tensor>
+    util.list.set %results[%c0], %m1 : !util.list<!cudnn.tensor>
+    util.list.set %results[%c1], %m2 : !util.list<!cudnn.tensor>
+
+    %multi = call @cudnn.graph.create.list(%results)
+               : (!util.list<!cudnn.tensor>) -> !cudnn.operation_graph
+
+    // CHECK: Graph: CUDNN_BACKEND_OPERATIONGRAPH_DESCRIPTOR has 2operations
+    call @cudnn.debug.graph(%multi) : (!cudnn.operation_graph) -> ()
+
+    //===------------------------------------------------------------------===//
+    // Deep residual chain of 16 blocks: `x[i+1] = add(relu(x[i]), x[i])`.
+    //
+    // Without deduplication every residual block doubles the number of visited
+    // operations, and the graph would end up with ~2^17 operations.
+    //===------------------------------------------------------------------===//
+
+    %c16 = arith.constant 16 : index
+    %c1_i64 = arith.constant 1 : i64
+    %c2_i64 = arith.constant 2 : i64
+
+    %r_uid0 = arith.constant 100 : i64
+    %r0 = call @cudnn.tensor.arg(%dtype, %dims, %r_uid0, %alignment)
+            : (i64, !util.list<i64>, i64, i64) -> !cudnn.tensor
+
+    %r16, %r_uid = scf.for %i = %c0 to %c16 step %c1
+        iter_args(%x = %r0, %uid = %r_uid0) -> (!cudnn.tensor, i64) {
+      %relu_uid = arith.addi %uid, %c1_i64 : i64
+      %add_uid = arith.addi %uid, %c2_i64 : i64
+      %relu = func.call @cudnn.pointwise_relu(%x, %lower, %upper, %relu_uid,
+                                              %alignment)
+                : (!cudnn.tensor, f32, f32, i64, i64) -> !cudnn.tensor
+      %add = func.call @cudnn.pointwise_add(%relu, %x, %add_uid, %alignment)
+               : (!cudnn.tensor, !cudnn.tensor, i64, i64) -> !cudnn.tensor
+      scf.yield %add, %add_uid : !cudnn.tensor, i64
+    }
+
+    %residual = call @cudnn.graph.create(%r16)
+                  : (!cudnn.tensor) -> !cudnn.operation_graph
+
+    // CHECK: Graph: CUDNN_BACKEND_OPERATIONGRAPH_DESCRIPTOR has 32operations
+    call @cudnn.debug.graph(%residual) : (!cudnn.operation_graph) -> ()
+
+    return
+  }
+
+}
@@ -0,0 +1,159 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/handle_pool.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+
+#include "iree/testing/gtest.h"
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+//===----------------------------------------------------------------------===//
+// Stub cuDNN library that hands out fake handles and records their streams.
+//===----------------------------------------------------------------------===//
+
+static uintptr_t next_handle = 0;
+static int64_t num_live_handles = 0;
+static std::unordered_map<cudnnHandle_t, cudaStream_t> handle_streams;
+
+static cudnnStatus_t StubCreate(cudnnHandle_t* handle) {
+  *handle = reinterpret_cast<cudnnHandle_t>(++next_handle);
+  ++num_live_handles;
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static cudnnStatus_t StubDestroy(cudnnHandle_t handle) {
+  handle_streams.erase(handle);
+  --num_live_handles;
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static cudnnStatus_t StubSetStream(cudnnHandle_t handle, cudaStream_t stream) {
+  handle_streams[handle] = stream;
+  return CUDNN_STATUS_SUCCESS;
+}
+
+static const char* StubGetErrorString(cudnnStatus_t) { return "stub"; }
+
+static openxla_cudnn_dynamic_symbols_t StubSymbols() {
+  openxla_cudnn_dynamic_symbols_t syms = {};
+  syms.cudnnCreate = StubCreate;
+  syms.cudnnDestroy = StubDestroy;
+  syms.cudnnSetStream = StubSetStream;
+  syms.cudnnGetErrorString = StubGetErrorString;
+  return syms;
+}
+
+static CUcontext FakeContext(uintptr_t value) {
+  return reinterpret_cast<CUcontext>(value);
+}
+
+static CUstream FakeStream(uintptr_t value) {
+  return reinterpret_cast<CUstream>(value);
+}
+
+class HandlePoolTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    num_live_handles = 0;
+    handle_streams.clear();
+  }
+
+  HandlePool::Handle AcquireOrDie(HandlePool& pool, CUcontext ctx,
+                                  CUstream stream) {
+    auto handle = pool.Acquire(ctx, stream);
+    EXPECT_TRUE(handle.ok());
+    return std::move(*handle);
+  }
+
+  openxla_cudnn_dynamic_symbols_t syms_ = StubSymbols();
+};
+
+TEST_F(HandlePoolTest, ReusesReturnedHandles) {
+  HandlePool pool(&syms_);
+
+  cudnnHandle_t first;
+  {
+    HandlePool::Handle handle =
+        AcquireOrDie(pool, FakeContext(1), FakeStream(1));
+    first = handle.get();
+    EXPECT_EQ(handle_streams[first], FakeStream(1));
+    EXPECT_EQ(pool.stats().num_lent, 1);
+  }
+  EXPECT_EQ(pool.stats().num_lent, 0);
+  EXPECT_EQ(pool.stats().num_idle, 1);
+
+  HandlePool::Handle handle = AcquireOrDie(pool, FakeContext(1), FakeStream(1));
+  EXPECT_EQ(handle.get(), first);
+
+  HandlePoolStats stats = pool.stats();
+  EXPECT_EQ(stats.num_created, 1);
+  EXPECT_EQ(stats.num_reused, 1);
+  EXPECT_EQ(stats.num_lent, 1);
+  EXPECT_EQ(stats.num_idle, 0);
+}
+
+TEST_F(HandlePoolTest, KeyedByContextAndStream) {
+  HandlePool pool(&syms_);
+
+  // Return handles for two streams in the same context to the pool.
+  {
+    HandlePool::Handle a = AcquireOrDie(pool, FakeContext(1), FakeStream(1));
+    HandlePool::Handle b = AcquireOrDie(pool, FakeContext(1), FakeStream(2));
+  }
+  EXPECT_EQ(pool.stats().num_idle, 2);
+
+  // Idle handles can't be lent to another context or stream.
+  HandlePool::Handle c = AcquireOrDie(pool, FakeContext(2), FakeStream(1));
+  HandlePool::Handle d = AcquireOrDie(pool, FakeContext(1), FakeStream(3));
+  EXPECT_EQ(handle_streams[d.get()], FakeStream(3));
+  EXPECT_EQ(pool.stats().num_created, 4);
+  EXPECT_EQ(pool.stats().num_reused, 0);
+
+  HandlePool::Handle e = AcquireOrDie(pool, FakeContext(1), FakeStream(2));
+  EXPECT_EQ(handle_streams[e.get()], FakeStream(2));
+  EXPECT_EQ(pool.stats().num_reused, 1);
+}
+
+TEST_F(HandlePoolTest, MoveHandle) {
+  HandlePool pool(&syms_);
+
+  HandlePool::Handle a = AcquireOrDie(pool, FakeContext(1), FakeStream(1));
+  cudnnHandle_t handle = a.get();
+
+  HandlePool::Handle b = std::move(a);
+  EXPECT_EQ(a.get(), nullptr);
+  EXPECT_EQ(b.get(), handle);
+
+  a.Reset();
+  EXPECT_EQ(pool.stats().num_lent, 1);
+
+  b.Reset();
+  EXPECT_EQ(pool.stats().num_lent, 0);
+  EXPECT_EQ(pool.stats().num_idle, 1);
+}
+
+TEST_F(HandlePoolTest, DestroysIdleHandles) {
+  {
+    HandlePool pool(&syms_);
+    HandlePool::Handle a = AcquireOrDie(pool, FakeContext(1), FakeStream(1));
+    HandlePool::Handle b = AcquireOrDie(pool, FakeContext(1), FakeStream(1));
+    a.Reset();
+    EXPECT_EQ(num_live_handles, 2);
+
+    pool.Clear();
+    EXPECT_EQ(num_live_handles, 1);
+    EXPECT_EQ(pool.stats().num_idle, 0);
+  }
+  EXPECT_EQ(num_live_handles, 0);
+}
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
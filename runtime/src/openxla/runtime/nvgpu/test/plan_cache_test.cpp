@@ -0,0 +1,88 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/plan_cache.h"
+
+#include <string>
+
+#include "iree/testing/gtest.h"
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+TEST(PlanCacheTest, HitsAndMisses) {
+  PlanCache<std::string> cache(/*capacity_bytes=*/1024);
+
+  EXPECT_FALSE(cache.Lookup(1).has_value());
+  cache.Insert(1, "plan-1", 16);
+
+  auto cached = cache.Lookup(1);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(*cached, "plan-1");
+
+  PlanCacheStats stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.num_entries, 1);
+  EXPECT_EQ(stats.size_bytes, 16);
+}
+
+TEST(PlanCacheTest, ReplaceExistingEntry) {
+  PlanCache<std::string> cache(/*capacity_bytes=*/1024);
+
+  cache.Insert(1, "plan-1", 16);
+  cache.Insert(1, "plan-2", 32);
+  EXPECT_EQ(*cache.Lookup(1), "plan-2");
+
+  PlanCacheStats stats = cache.stats();
+  EXPECT_EQ(stats.num_entries, 1);
+  EXPECT_EQ(stats.size_bytes, 32);
+}
+
+TEST(PlanCacheTest, EvictLeastRecentlyUsed) {
+  PlanCache<std::string> cache(/*capacity_bytes=*/64);
+
+  cache.Insert(1, "plan-1", 32);
+  cache.Insert(2, "plan-2", 32);
+
+  // Touch the first entry, so that the second one becomes the LRU entry.
+  EXPECT_TRUE(cache.Lookup(1).has_value());
+
+  cache.Insert(3, "plan-3", 32);
+  EXPECT_TRUE(cache.Lookup(1).has_value());
+  EXPECT_FALSE(cache.Lookup(2).has_value());
+  EXPECT_TRUE(cache.Lookup(3).has_value());
+
+  PlanCacheStats stats = cache.stats();
+  EXPECT_EQ(stats.evictions, 1);
+  EXPECT_EQ(stats.num_entries, 2);
+  EXPECT_EQ(stats.size_bytes, 64);
+}
+
+TEST(PlanCacheTest, DoNotCacheLargeValues) {
+  PlanCache<std::string> cache(/*capacity_bytes=*/64);
+
+  cache.Insert(1, "plan-1", 32);
+  cache.Insert(2, "plan-2", 128);
+  EXPECT_TRUE(cache.Lookup(1).has_value());
+  EXPECT_FALSE(cache.Lookup(2).has_value());
+  EXPECT_EQ(cache.stats().evictions, 0);
+}
+
+TEST(PlanCacheTest, Clear) {
+  PlanCache<std::string> cache(/*capacity_bytes=*/64);
+
+  cache.Insert(1, "plan-1", 32);
+  cache.Clear();
+  EXPECT_FALSE(cache.Lookup(1).has_value());
+
+  PlanCacheStats stats = cache.stats();
+  EXPECT_EQ(stats.num_entries, 0);
+  EXPECT_EQ(stats.size_bytes, 0);
+}
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
@@ -0,0 +1,171 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/plan_database.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "iree/testing/gtest.h"
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+static std::string TempPath(const char* name) {
+  std::string path = ::testing::TempDir() + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+static std::unique_ptr<PlanDatabase> LoadOrDie(const std::string& path) {
+  auto database = PlanDatabase::Load(path, iree_allocator_system());
+  EXPECT_TRUE(database.ok());
+  return std::move(*database);
+}
+
+TEST(PlanDatabaseTest, MissingFile) {
+  auto database = LoadOrDie(TempPath("missing.cudnn_plans"));
+  EXPECT_EQ(database->size(), 0);
+  EXPECT_FALSE(database->Lookup({1, 8900, 80}).has_value());
+}
+
+TEST(PlanDatabaseTest, SaveAndLoad) {
+  std::string path = TempPath("save_and_load.cudnn_plans");
+
+  PlanDatabaseKey key = {/*graph_fingerprint=*/42, /*cudnn_version=*/8900,
+                         /*compute_capability=*/80};
+  PlanDatabaseValue value = {/*engine_id=*/7, /*knobs=*/{{1, 2}, {3, 4}}};
+
+  auto database = LoadOrDie(path);
+  ASSERT_TRUE(database->Insert(key, value).ok());
+  ASSERT_TRUE(database->Insert({1, 8900, 80}, {3, {}}).ok());
+  ASSERT_TRUE(database->Save().ok());
+
+  auto loaded = LoadOrDie(path);
+  EXPECT_EQ(loaded->size(), 2);
+
+  auto recorded = loaded->Lookup(key);
+  ASSERT_TRUE(recorded.has_value());
+  EXPECT_EQ(recorded->engine_id, 7);
+  EXPECT_EQ(recorded->knobs, value.knobs);
+
+  // Engine configs are not shared between cuDNN versions, devices and
+  // workspace limits.
+  EXPECT_FALSE(loaded->Lookup({42, 8901, 80}).has_value());
+  EXPECT_FALSE(loaded->Lookup({42, 8900, 90}).has_value());
+  EXPECT_FALSE(loaded->Lookup({42, 8900, 80, 1024}).has_value());
+}
+
+TEST(PlanDatabaseTest, MergeWithLoadedRecords) {
+  std::string path = TempPath("merge.cudnn_plans");
+
+  auto database = LoadOrDie(path);
+  ASSERT_TRUE(database->Insert({1, 8900, 80}, {1, {}}).ok());
+  ASSERT_TRUE(database->Insert({2, 8900, 80}, {2, {}}).ok());
+  ASSERT_TRUE(database->Save().ok());
+
+  auto updated = LoadOrDie(path);
+  ASSERT_TRUE(updated->Insert({2, 8900, 80}, {20, {}}).ok());
+  ASSERT_TRUE(updated->Insert({3, 8900, 80}, {3, {}}).ok());
+  ASSERT_TRUE(updated->Save().ok());
+
+  auto loaded = LoadOrDie(path);
+  EXPECT_EQ(loaded->size(), 3);
+  EXPECT_EQ(loaded->Lookup({1, 8900, 80})->engine_id, 1);
+  EXPECT_EQ(loaded->Lookup({2, 8900, 80})->engine_id, 20);
+  EXPECT_EQ(loaded->Lookup({3, 8900, 80})->engine_id, 3);
+}
+
+TEST(PlanDatabaseTest, IgnoreInvalidFile) {
+  std::string path = TempPath("invalid.cudnn_plans");
+
+  FILE* file = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  std::fputs("not a plan database", file);
+  std::fclose(file);
+
+  auto database = LoadOrDie(path);
+  EXPECT_EQ(database->size(), 0);
+}
+
+// Reads the whole file into a string.
+static std::string ReadFile(const std::string& path) {
+  std::string data;
+  FILE* file = std::fopen(path.c_str(), "rb");
+  EXPECT_NE(file, nullptr);
+  char buffer[1024];
+  while (size_t n = std::fread(buffer, 1, sizeof(buffer), file))
+    data.append(buffer, n);
+  std::fclose(file);
+  return data;
+}
+
+static void WriteFile(const std::string& path, const std::string& data) {
+  FILE* file = std::fopen(path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  std::fwrite(data.data(), 1, data.size(), file);
+  std::fclose(file);
+}
+
+// Saves a database with two records, and returns the file contents together
+// with the size of a single record.
+static std::pair<std::string, size_t> SaveTwoRecords(const std::string& path) {
+  auto database = LoadOrDie(path);
+  EXPECT_TRUE(database->Insert({1, 8900, 80}, {1, {{1, 2}}}).ok());
+  EXPECT_TRUE(database->Insert({2, 8900, 80}, {2, {{3, 4}}}).ok());
+  EXPECT_TRUE(database->Save().ok());
+
+  std::string data = ReadFile(path);
+  size_t header_size = 24;  // magic, version, record size, number of records
+  return {data, (data.size() - header_size) / 2};
+}
+
+TEST(PlanDatabaseTest, IgnoreUnsortedFile) {
+  std::string path = TempPath("unsorted.cudnn_plans");
+  auto [data, record_size] = SaveTwoRecords(path);
+
+  // Swap the two records.
+  size_t first = data.size() - 2 * record_size;
+  std::string record = data.substr(first, record_size);
+  data.replace(first, record_size, data.substr(first + record_size));
+  data.replace(first + record_size, record_size, record);
+  WriteFile(path, data);
+
+  auto database = LoadOrDie(path);
+  EXPECT_EQ(database->size(), 0);
+  EXPECT_FALSE(database->Lookup({1, 8900, 80}).has_value());
+}
+
+TEST(PlanDatabaseTest, IgnoreInvalidNumKnobs) {
+  for (int64_t num_knobs : {int64_t{-1}, PlanDatabase::kMaxKnobs + 1}) {
+    std::string path = TempPath("invalid_num_knobs.cudnn_plans");
+    auto [data, record_size] = SaveTwoRecords(path);
+
+    // Number of knobs follows the fingerprint, cuDNN version, compute
+    // capability, workspace limit and engine id in the last record.
+    size_t offset = data.size() - record_size + 5 * sizeof(int64_t);
+    data.replace(offset, sizeof(int64_t),
+                 reinterpret_cast<const char*>(&num_knobs), sizeof(int64_t));
+    WriteFile(path, data);
+
+    auto database = LoadOrDie(path);
+    EXPECT_EQ(database->size(), 0);
+    EXPECT_FALSE(database->Lookup({2, 8900, 80}).has_value());
+  }
+}
+
+TEST(PlanDatabaseTest, TooManyKnobs) {
+  auto database = LoadOrDie(TempPath("too_many_knobs.cudnn_plans"));
+
+  PlanDatabaseValue value;
+  value.knobs.resize(PlanDatabase::kMaxKnobs + 1);
+  EXPECT_FALSE(database->Insert({1, 8900, 80}, value).ok());
+}
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
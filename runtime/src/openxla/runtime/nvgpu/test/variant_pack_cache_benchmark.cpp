@@ -0,0 +1,94 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "openxla/runtime/nvgpu/small_vector.h"
+#include "openxla/runtime/nvgpu/variant_pack_cache.h"
+
+// Count all heap allocations in the benchmark binary.
+static std::atomic<int64_t> num_allocations = 0;
+
+void* operator new(size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+// Fake variant pack that allocates host memory just like cuDNN backend
+// descriptors built by the cudnn_frontend.
+struct FakeVariantPack {
+  std::vector<void*> ptrs;
+  std::vector<int64_t> uids;
+};
+
+static iree::StatusOr<FakeVariantPack> Create(iree::span<void* const> ptrs,
+                                              void* workspace) {
+  return FakeVariantPack{{ptrs.begin(), ptrs.end()},
+                         std::vector<int64_t>(ptrs.size())};
+}
+
+// Simulates the host side of the cuDNN executable launch: collects device
+// pointers for all graph tensors and gets a variant pack for them.
+template <typename Cache>
+static void Execute(Cache& cache, iree::span<void* const> buffers) {
+  SmallVector<void*, 8> ptrs(buffers.size());
+  for (size_t i = 0; i < buffers.size(); ++i) ptrs[i] = buffers[i];
+  auto variant_pack = cache.GetOrCreate(ptrs, nullptr, Create);
+  benchmark::DoNotOptimize(variant_pack);
+}
+
+static void ReportAllocations(benchmark::State& state, int64_t allocations) {
+  state.counters["allocs_per_execute"] = benchmark::Counter(
+      static_cast<double>(allocations) / state.iterations());
+}
+
+// Launches with the same buffers (e.g. pooled allocations) do not allocate.
+static void BM_ExecuteSameBuffers(benchmark::State& state) {
+  VariantPackCache<FakeVariantPack> cache;
+  std::vector<void*> buffers(state.range(0));
+  for (size_t i = 0; i < buffers.size(); ++i)
+    buffers[i] = reinterpret_cast<void*>(0x1000 * (i + 1));
+
+  int64_t allocations = num_allocations.load();
+  for (auto _ : state) Execute(cache, buffers);
+  ReportAllocations(state, num_allocations.load() - allocations);
+}
+
+// Launches cycling through more buffer sets than the cache capacity build a
+// new variant pack every time.
+static void BM_ExecuteRotatingBuffers(benchmark::State& state) {
+  VariantPackCache<FakeVariantPack> cache;
+  std::vector<std::vector<void*>> buffer_sets(8);
+  for (size_t s = 0; s < buffer_sets.size(); ++s) {
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      buffer_sets[s].push_back(
+          reinterpret_cast<void*>(0x100000 * (s + 1) + 0x1000 * i));
+    }
+  }
+
+  int64_t allocations = num_allocations.load();
+  size_t iteration = 0;
+  for (auto _ : state)
+    Execute(cache, buffer_sets[iteration++ % buffer_sets.size()]);
+  ReportAllocations(state, num_allocations.load() - allocations);
+}
+
+BENCHMARK(BM_ExecuteSameBuffers)->Arg(2)->Arg(8)->Arg(16);
+BENCHMARK(BM_ExecuteRotatingBuffers)->Arg(2)->Arg(8)->Arg(16);
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
@@ -0,0 +1,100 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/variant_pack_cache.h"
+
+#include <vector>
+
+#include "iree/testing/gtest.h"
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+using iree::Status;
+using iree::StatusCode;
+using iree::StatusOr;
+
+// Fake variant pack that records device pointers it was created for.
+struct FakeVariantPack {
+  std::vector<void*> ptrs;
+  void* workspace;
+};
+
+static StatusOr<FakeVariantPack> Create(iree::span<void* const> ptrs,
+                                        void* workspace) {
+  return FakeVariantPack{{ptrs.begin(), ptrs.end()}, workspace};
+}
+
+static void* Ptr(uintptr_t value) { return reinterpret_cast<void*>(value); }
+
+TEST(VariantPackCacheTest, HitsAndMisses) {
+  VariantPackCache<FakeVariantPack> cache;
+  std::vector<void*> ptrs = {Ptr(1), Ptr(2)};
+
+  auto created = cache.GetOrCreate(ptrs, Ptr(3), Create);
+  ASSERT_TRUE(created.ok());
+  EXPECT_EQ((*created)->ptrs, ptrs);
+  EXPECT_EQ((*created)->workspace, Ptr(3));
+
+  auto cached = cache.GetOrCreate(ptrs, Ptr(3), Create);
+  ASSERT_TRUE(cached.ok());
+  EXPECT_EQ(*cached, *created);
+
+  // Different workspace pointer requires a new variant pack.
+  auto other = cache.GetOrCreate(ptrs, Ptr(4), Create);
+  ASSERT_TRUE(other.ok());
+  EXPECT_NE(*other, *created);
+
+  VariantPackCacheStats stats = cache.stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 2);
+}
+
+TEST(VariantPackCacheTest, EvictLeastRecentlyUsed) {
+  VariantPackCache<FakeVariantPack, /*kCapacity=*/2> cache;
+  std::vector<void*> a = {Ptr(1)}, b = {Ptr(2)}, c = {Ptr(3)};
+
+  ASSERT_TRUE(cache.GetOrCreate(a, nullptr, Create).ok());
+  ASSERT_TRUE(cache.GetOrCreate(b, nullptr, Create).ok());
+  ASSERT_TRUE(cache.GetOrCreate(a, nullptr, Create).ok());  // hit
+  ASSERT_TRUE(cache.GetOrCreate(c, nullptr, Create).ok());  // evicts `b`
+  ASSERT_TRUE(cache.GetOrCreate(a, nullptr, Create).ok());  // hit
+  ASSERT_TRUE(cache.GetOrCreate(b, nullptr, Create).ok());  // miss
+
+  VariantPackCacheStats stats = cache.stats();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 4);
+}
+
+TEST(VariantPackCacheTest, LargeNumberOfPointers) {
+  VariantPackCache<FakeVariantPack, /*kCapacity=*/2, /*kInlinePointers=*/2>
+      cache;
+  std::vector<void*> ptrs = {Ptr(1), Ptr(2), Ptr(3), Ptr(4)};
+
+  ASSERT_TRUE(cache.GetOrCreate(ptrs, nullptr, Create).ok());
+  auto cached = cache.GetOrCreate(ptrs, nullptr, Create);
+  ASSERT_TRUE(cached.ok());
+  EXPECT_EQ((*cached)->ptrs, ptrs);
+  EXPECT_EQ(cache.stats().hits, 1);
+}
+
+TEST(VariantPackCacheTest, DoNotCacheErrors) {
+  VariantPackCache<FakeVariantPack> cache;
+  std::vector<void*> ptrs = {Ptr(1)};
+
+  auto failed = cache.GetOrCreate(
+      ptrs, nullptr,
+      [](iree::span<void* const>, void*) -> StatusOr<FakeVariantPack> {
+        return Status(StatusCode::kInternal, "failed to create variant pack");
+      });
+  EXPECT_FALSE(failed.ok());
+
+  ASSERT_TRUE(cache.GetOrCreate(ptrs, nullptr, Create).ok());
+  EXPECT_EQ(cache.stats().misses, 2);
+}
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
@@ -0,0 +1,161 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/workspace_arena.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "iree/testing/gtest.h"
+
+namespace openxla::runtime::nvgpu {
+namespace {
+
+using iree::OkStatus;
+using iree::Status;
+using iree::StatusOr;
+
+// Fake allocator that hands out non-overlapping fake device addresses and
+// records all allocations and frees.
+class FakeAllocator : public WorkspaceAllocator {
+ public:
+  StatusOr<void*> Allocate(size_t size) override {
+    void* ptr = reinterpret_cast<void*>(next_);
+    next_ += size + 4096;
+    allocations_.push_back(size);
+    return ptr;
+  }
+
+  Status Free(void* ptr) override {
+    frees_.push_back(ptr);
+    return OkStatus();
+  }
+
+  std::vector<size_t> allocations_;
+  std::vector<void*> frees_;
+
+ private:
+  uintptr_t next_ = 0x10000;
+};
+
+static uintptr_t Addr(void* ptr) { return reinterpret_cast<uintptr_t>(ptr); }
+
+TEST(WorkspaceArenaTest, EmptyWorkspace) {
+  FakeAllocator allocator;
+  WorkspaceArena arena(&allocator);
+
+  auto ptr = arena.Allocate(0);
+  ASSERT_TRUE(ptr.ok());
+  EXPECT_EQ(*ptr, nullptr);
+  EXPECT_TRUE(allocator.allocations_.empty());
+}
+
+TEST(WorkspaceArenaTest, BumpAllocate) {
+  FakeAllocator allocator;
+  WorkspaceArena arena(&allocator);
+
+  // First allocation creates a block of the requested (aligned) size.
+  auto a = arena.Allocate(100);
+  ASSERT_TRUE(a.ok());
+  EXPECT_EQ(allocator.allocations_, std::vector<size_t>({256}));
+
+  // Reset makes the memory available again without new allocations.
+  ASSERT_TRUE(arena.Reset().ok());
+  auto b = arena.Allocate(200);
+  ASSERT_TRUE(b.ok());
+  EXPECT_EQ(*a, *b);
+  EXPECT_EQ(allocator.allocations_.size(), 1);
+
+  WorkspaceArenaStats stats = arena.stats();
+  EXPECT_EQ(stats.peak_bytes, 256);
+  EXPECT_EQ(stats.capacity_bytes, 256);
+  EXPECT_EQ(stats.num_grows, 1);
+  EXPECT_EQ(stats.num_allocations, 2);
+}
+
+TEST(WorkspaceArenaTest, GrowToLargestWorkspace) {
+  FakeAllocator allocator;
+  WorkspaceArena arena(&allocator);
+
+  auto a = arena.Allocate(256);
+  ASSERT_TRUE(a.ok());
+  ASSERT_TRUE(arena.Reset().ok());
+
+  // Larger workspace replaces the block, and the replaced block is released
+  // on the next reset.
+  auto b = arena.Allocate(1024);
+  ASSERT_TRUE(b.ok());
+  EXPECT_EQ(allocator.allocations_, std::vector<size_t>({256, 1024}));
+  EXPECT_TRUE(allocator.frees_.empty());
+  ASSERT_TRUE(arena.Reset().ok());
+  EXPECT_EQ(allocator.frees_, std::vector<void*>({*a}));
+
+  // Smaller workspaces fit into the existing block.
+  auto c = arena.Allocate(512);
+  ASSERT_TRUE(c.ok());
+  EXPECT_EQ(*c, *b);
+  EXPECT_EQ(allocator.allocations_.size(), 2);
+
+  WorkspaceArenaStats stats = arena.stats();
+  EXPECT_EQ(stats.peak_bytes, 1024);
+  EXPECT_EQ(stats.num_grows, 2);
+}
+
+TEST(WorkspaceArenaTest, MultipleLaunchesBetweenResets) {
+  FakeAllocator allocator;
+  WorkspaceArena arena(&allocator);
+
+  // Workspaces of launches in flight do not overlap, and the block replaced
+  // by a larger one is not released while its workspace can be in use.
+  auto a = arena.Allocate(256);
+  auto b = arena.Allocate(512);
+  ASSERT_TRUE(a.ok() && b.ok());
+  EXPECT_EQ(allocator.allocations_, std::vector<size_t>({256, 768}));
+  EXPECT_TRUE(allocator.frees_.empty());
+  ASSERT_TRUE(arena.Reset().ok());
+  EXPECT_EQ(allocator.frees_, std::vector<void*>({*a}));
+
+  // After reset all workspaces fit into a single block.
+  auto c = arena.Allocate(256);
+  auto d = arena.Allocate(512);
+  ASSERT_TRUE(c.ok() && d.ok());
+  EXPECT_EQ(Addr(*d) - Addr(*c), 256);
+  EXPECT_EQ(allocator.allocations_.size(), 2);
+
+  WorkspaceArenaStats stats = arena.stats();
+  EXPECT_EQ(stats.peak_bytes, 768);
+  EXPECT_EQ(stats.capacity_bytes, 768);
+}
+
+TEST(WorkspaceArenaTest, FreeOnDestruction) {
+  FakeAllocator allocator;
+  void* block = nullptr;
+  {
+    WorkspaceArena arena(&allocator);
+    auto ptr = arena.Allocate(128);
+    ASSERT_TRUE(ptr.ok());
+    block = *ptr;
+  }
+  EXPECT_EQ(allocator.frees_, std::vector<void*>({block}));
+}
+
+TEST(WorkspaceArenaTest, FreeRetiredOnDestruction) {
+  FakeAllocator allocator;
+  void* retired = nullptr;
+  void* block = nullptr;
+  {
+    WorkspaceArena arena(&allocator);
+    auto a = arena.Allocate(128);
+    auto b = arena.Allocate(1024);
+    ASSERT_TRUE(a.ok() && b.ok());
+    retired = *a;
+    block = *b;
+  }
+  EXPECT_EQ(allocator.frees_, std::vector<void*>({retired, block}));
+}
+
+}  // namespace
+}  // namespace openxla::runtime::nvgpu
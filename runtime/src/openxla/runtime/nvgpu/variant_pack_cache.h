@@ -0,0 +1,107 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef OPENXLA_RUNTIME_NVGPU_VARIANT_PACK_CACHE_H_
+#define OPENXLA_RUNTIME_NVGPU_VARIANT_PACK_CACHE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "iree/base/internal/span.h"
+#include "iree/base/status_cc.h"
+#include "openxla/runtime/nvgpu/small_vector.h"
+
+namespace openxla::runtime::nvgpu {
+
+// Statistics of the variant pack cache usage.
+struct VariantPackCacheStats {
+  int64_t hits = 0;
+  int64_t misses = 0;
+};
+
+// Cache of variant packs (device pointers bound to cuDNN graph tensors, and
+// a workspace pointer) keyed by the tuple of device pointers. Building a
+// variant pack creates and finalizes a cuDNN backend descriptor, and for small
+// graphs it can take longer than the kernel execution itself. Callers that
+// reuse the same buffers (e.g. pooled allocations) get cached variant packs
+// without any heap allocations.
+//
+// The cache has a small fixed capacity and uses linear search, which is faster
+// than hashing for a handful of entries, and evicts least recently used
+// entries. Cache is not thread-safe and must be externally synchronized.
+//
+// Value type is a template parameter to be able to test and benchmark cache
+// without loading cuDNN library (executables instantiate it with
+// `cudnn_frontend::VariantPack`).
+template <typename Value, size_t kCapacity = 4, size_t kInlinePointers = 8>
+class VariantPackCache {
+ public:
+  // Returns a value cached for the device pointers, or creates a new one by
+  // calling `create(ptrs, workspace)` returning `StatusOr<Value>`.
+  template <typename Create>
+  iree::StatusOr<const Value*> GetOrCreate(iree::span<void* const> ptrs,
+                                           void* workspace, Create&& create);
+
+  // Destroys all cached values.
+  void Clear() {
+    for (Entry& entry : entries_) {
+      entry.value.reset();
+      entry.last_use = 0;
+    }
+  }
+
+  VariantPackCacheStats stats() const { return stats_; }
+
+ private:
+  struct Entry {
+    SmallVector<void*, kInlinePointers> ptrs;
+    void* workspace = nullptr;
+    std::optional<Value> value;
+    uint64_t last_use = 0;
+  };
+
+  std::array<Entry, kCapacity> entries_;
+  uint64_t use_counter_ = 0;
+  VariantPackCacheStats stats_;
+};
+
+//===----------------------------------------------------------------------===//
+// VariantPackCache implementation.
+//===----------------------------------------------------------------------===//
+
+template <typename Value, size_t kCapacity, size_t kInlinePointers>
+template <typename Create>
+iree::StatusOr<const Value*>
+VariantPackCache<Value, kCapacity, kInlinePointers>::GetOrCreate(
+    iree::span<void* const> ptrs, void* workspace, Create&& create) {
+  Entry* lru = &entries_[0];
+
+  for (Entry& entry : entries_) {
+    if (entry.value && entry.workspace == workspace && entry.ptrs == ptrs) {
+      ++stats_.hits;
+      entry.last_use = ++use_counter_;
+      return &*entry.value;
+    }
+    // Empty entries have zero last use and are replaced first.
+    if (entry.last_use < lru->last_use) lru = &entry;
+  }
+
+  ++stats_.misses;
+  IREE_ASSIGN_OR_RETURN(Value value, create(ptrs, workspace));
+
+  lru->ptrs.assign(ptrs);
+  lru->workspace = workspace;
+  lru->value.emplace(std::move(value));
+  lru->last_use = ++use_counter_;
+  return &*lru->value;
+}
+
+}  // namespace openxla::runtime::nvgpu
+
+#endif  // OPENXLA_RUNTIME_NVGPU_VARIANT_PACK_CACHE_H_
@@ -0,0 +1,64 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "openxla/runtime/nvgpu/workspace_arena.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace openxla::runtime::nvgpu {
+
+using namespace iree;
+
+static size_t AlignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+WorkspaceArena::~WorkspaceArena() {
+  for (uint8_t* block : retired_) allocator_->Free(block).IgnoreError();
+  if (block_) allocator_->Free(block_).IgnoreError();
+}
+
+StatusOr<void*> WorkspaceArena::Allocate(size_t size) {
+  if (size == 0) return nullptr;
+  size = AlignUp(size, kAlignment);
+
+  if (offset_ + size > stats_.capacity_bytes) {
+    // Grow to fit all workspaces requested since the last reset, so that the
+    // next time they all fit into a single block.
+    size_t capacity = used_ + size;
+    IREE_ASSIGN_OR_RETURN(void* block, allocator_->Allocate(capacity));
+    if (block_) retired_.push_back(block_);
+
+    block_ = static_cast<uint8_t*>(block);
+    offset_ = 0;
+    stats_.capacity_bytes = capacity;
+    ++stats_.num_grows;
+  }
+
+  void* ptr = block_ + offset_;
+  offset_ += size;
+  used_ += size;
+
+  stats_.peak_bytes = std::max(stats_.peak_bytes, used_);
+  ++stats_.num_allocations;
+  return ptr;
+}
+
+Status WorkspaceArena::Reset() {
+  offset_ = 0;
+  used_ = 0;
+
+  Status status;
+  for (uint8_t* block : retired_) {
+    Status freed = allocator_->Free(block);
+    if (status.ok()) status = std::move(freed);
+  }
+  retired_.clear();
+  return status;
+}
+
+}  // namespace openxla::runtime::nvgpu
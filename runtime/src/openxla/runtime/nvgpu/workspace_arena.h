@@ -0,0 +1,97 @@
+// Copyright 2023 The OpenXLA Authors
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef OPENXLA_RUNTIME_NVGPU_WORKSPACE_ARENA_H_
+#define OPENXLA_RUNTIME_NVGPU_WORKSPACE_ARENA_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "iree/base/status_cc.h"
+
+namespace openxla::runtime::nvgpu {
+
+// Allocator of device memory blocks backing the workspace arena. All
+// operations are stream-ordered: memory can be used by the work submitted to
+// the stream after the allocation, and it is released only after all work
+// submitted to the stream before the free completes.
+class WorkspaceAllocator {
+ public:
+  virtual ~WorkspaceAllocator() = default;
+
+  virtual iree::StatusOr<void*> Allocate(size_t size) = 0;
+  virtual iree::Status Free(void* ptr) = 0;
+};
+
+// Statistics of the workspace arena usage.
+struct WorkspaceArenaStats {
+  // Maximum number of bytes sub-allocated between two arena resets.
+  size_t peak_bytes = 0;
+  // Size of the current device memory block.
+  size_t capacity_bytes = 0;
+  // Number of times the arena had to allocate a larger block.
+  int64_t num_grows = 0;
+  // Number of sub-allocations.
+  int64_t num_allocations = 0;
+};
+
+// Workspace arena sub-allocates workspace for cuDNN execution plans from a
+// single device memory block with a bump pointer. All launches that use the
+// arena must be submitted to the same stream, and the arena must be reset
+// when workspace of previously submitted launches can be reused (for
+// stream-ordered launches that is before every new launch).
+//
+// Arena grows to the largest total workspace size requested between two
+// resets: when the block is too small, it is replaced with a new one, so the
+// arena never allocates after it has seen all execution plans. Workspaces
+// sub-allocated from the replaced block remain valid until the next reset, and
+// the block is released only when the arena is reset.
+class WorkspaceArena {
+ public:
+  // All sub-allocations are aligned to this number of bytes.
+  static constexpr size_t kAlignment = 256;
+
+  explicit WorkspaceArena(WorkspaceAllocator* allocator)
+      : allocator_(allocator) {}
+  ~WorkspaceArena();
+
+  // Returns a pointer to the workspace of at least `size` bytes that can be
+  // used until the arena is reset. Returns nullptr for empty workspace.
+  iree::StatusOr<void*> Allocate(size_t size);
+
+  // Makes all memory available for new sub-allocations, and releases blocks
+  // replaced since the last reset.
+  iree::Status Reset();
+
+  WorkspaceArenaStats stats() const { return stats_; }
+
+ private:
+  WorkspaceArena(const WorkspaceArena&) = delete;
+  WorkspaceArena& operator=(const WorkspaceArena&) = delete;
+
+  WorkspaceAllocator* allocator_;
+
+  // Current device memory block.
+  uint8_t* block_ = nullptr;
+
+  // Blocks replaced by a larger block since the last reset. Workspaces
+  // sub-allocated from them can still be in use.
+  std::vector<uint8_t*> retired_;
+
+  // Bump pointer offset in the current block.
+  size_t offset_ = 0;
+
+  // Bytes sub-allocated since the last reset (can be larger than `offset_` if
+  // the arena grew after the reset).
+  size_t used_ = 0;
+
+  WorkspaceArenaStats stats_;
+};
+
+}  // namespace openxla::runtime::nvgpu
+
+#endif  // OPENXLA_RUNTIME_NVGPU_WORKSPACE_ARENA_H_
@@ -6,16 +6,35 @@
 
 #include <stdio.h>
 
+#include "iree/base/internal/flags.h"
 #include "iree/modules/hal/types.h"
 #include "iree/runtime/api.h"
 #include "openxla/runtime/nvgpu/cudnn_module.h"
 
+IREE_FLAG(string, cudnn_plan_database, "",
+          "Path to the cuDNN plan database file with engine configs selected "
+          "in previous runs (disabled if empty).");
+IREE_FLAG(int32_t, cudnn_autotune_candidates, 0,
+          "Number of cuDNN execution plans timed on the device to select the "
+          "fastest one (autotuning is disabled if zero).");
+IREE_FLAG(int32_t, cudnn_autotune_warmup_iterations, 1,
+          "Number of untimed runs of each cuDNN autotuning candidate before "
+          "the timed runs.");
+IREE_FLAG(int32_t, cudnn_autotune_iterations, 10,
+          "Number of timed runs of each cuDNN autotuning candidate.");
+IREE_FLAG(bool, cudnn_autotune_persist, true,
+          "Records cuDNN autotuning results in the plan database.");
+IREE_FLAG(int64_t, cudnn_workspace_limit, 1024 * 1024 * 1024,
+          "Maximum workspace size (in bytes) that a selected cuDNN execution "
+          "plan can request.");
+
 // TODO: This is a temporary work around missing custom modules integration into
 // IREE tools (iree-run-module). We already have flags to enable plugins in
 // compiler tools (`iree-compiler` and `iree-opt`), but not yet in "runtime"
 // tools. This tool can only run VM function with empty arguments and empty
 // results, and intended for testing cuDNN custom module.
 int main(int argc, char** argv) {
+  iree_flags_parse_checked(IREE_FLAGS_PARSE_MODE_DEFAULT, &argc, &argv);
   if (argc != 3) {
     fprintf(stderr,
             "Usage:\n"
@@ -56,10 +75,20 @@ int main(int argc, char** argv) {
       iree_runtime_instance_host_allocator(instance), &session));
 
   // Create the custom module that can be reused across contexts.
+  iree_custom_module_cudnn_options_t cudnn_options;
+  iree_custom_module_cudnn_options_initialize(&cudnn_options);
+  cudnn_options.plan_database_path =
+      iree_make_cstring_view(FLAG_cudnn_plan_database);
+  cudnn_options.autotune_candidates = FLAG_cudnn_autotune_candidates;
+  cudnn_options.autotune_warmup_iterations =
+      FLAG_cudnn_autotune_warmup_iterations;
+  cudnn_options.autotune_iterations = FLAG_cudnn_autotune_iterations;
+  cudnn_options.autotune_persist = FLAG_cudnn_autotune_persist;
+  cudnn_options.workspace_limit = FLAG_cudnn_workspace_limit;
   iree_vm_module_t* custom_module = NULL;
   IREE_CHECK_OK(iree_custom_module_cudnn_create(
-      iree_runtime_instance_vm_instance(instance), device, host_allocator,
-      &custom_module));
+      iree_runtime_instance_vm_instance(instance), device, &cudnn_options,
+      host_allocator, &custom_module));
   IREE_CHECK_OK(iree_runtime_session_append_module(session, custom_module));
   iree_vm_module_release(custom_module);
 